@@ -4,6 +4,7 @@
 #include "logging/macro.h"
 
 #include <vector>
+#include <utility>
 #include <algorithm>
 
 #include <cstdint>
@@ -28,6 +29,9 @@ public:
     static constexpr size_t NSizeY = TLayer::NDomainLengthY;
     static constexpr size_t NMod = TStencil::NMod;
 
+    /// Cutoff rank of advance_forked() meaning the tiling's default one
+    static constexpr size_t NDefaultCutoffRank = SIZE_MAX;
+
     static_assert(NMod > 0, "NMod must be positive");
 
 /*
@@ -40,9 +44,18 @@ public:
         layers_arr_{}
     {}
 
-    template<typename TInitFunc>
-    WmGeneralSolver2D(double length, double dtime, TInitFunc&& init_func):
-        WmGeneralSolver2D(length, dtime)
+    /**
+     * @brief Initializes the solver passing the extra arguments to stencil
+     * Stencils like WmVelocityWaveStencil2D take their shared read-only 
+     * data this way, the rest ones are built of dspace and dtime only.
+     */
+    template<typename TInitFunc, typename... TStencilArgs>
+    WmGeneralSolver2D(double length, double dtime, TInitFunc&& init_func,
+                      TStencilArgs&&... stencil_args):
+        length_(length),
+        stencil_(length_ / NSizeY, dtime, 
+                 std::forward<TStencilArgs>(stencil_args)...),
+        layers_arr_{}
     {
         layers_arr_[NMod - 1]
             .init(length_, std::forward<TInitFunc>(init_func));
@@ -76,6 +89,35 @@ public:
 */
     }
 
+    /**
+     * @brief Executes proc_cnt steps forking independent folds as tasks
+     * Requires tiling supporting traverse_forked() (ConeFold one).
+     * @tparam NCutoffRank Maximal rank of the sequentially processed fold
+     * (NDefaultCutoffRank stands for the tiling's default one)
+     * @param proc_cnt Number of steps to do
+     */
+    template<size_t NCutoffRank = NDefaultCutoffRank>
+    void advance_forked(size_t proc_cnt)
+    {
+        static constexpr size_t NShift = (1u << NTileRank) % NMod;
+
+        // resolved here: other tilings have no NForkCutoffRank
+        static constexpr size_t NRank = NCutoffRank == NDefaultCutoffRank ?
+            TTiling::NForkCutoffRank : NCutoffRank;
+
+        for (size_t proc_idx = 0; proc_idx < proc_cnt; 
+             proc_idx += (1u << NTileRank))
+        {
+            TTiling::template traverse_forked<NRankX, NRank>
+                (stencil_, layers_arr_);
+
+            // rotate right to emulate dynamic programming with limited memory
+            std::rotate(std::rbegin(layers_arr_), 
+                        std::rbegin(layers_arr_) + NShift, 
+                        std::rend(layers_arr_));
+        }
+    }
+
 private:
     double length_;
     TStencil stencil_;
@@ -60,7 +60,7 @@ public:
     //------------------------------------------------------------ 
 
     WmGeneralLinearLayer2D():
-        data_vec_(NDomainLengthY * NDomainLengthX)
+        data_vec_(NDomainLengthY * NDomainLengthX, TData{})
     {}
 
     WmGeneralLinearLayer2D
@@ -75,10 +75,21 @@ public:
 
     template<typename FInitFunc>
     void init(double length, FInitFunc func)
+    {
+        init_rows(length, func, 0, NDomainLengthY);
+    }
+
+    /**
+     * @brief Initializes rows [y_begin, y_end) only
+     * Rows may be initialized from different threads concurrently.
+     */
+    template<typename FInitFunc>
+    void init_rows(double length, FInitFunc&& func,
+                   int64_t y_begin, int64_t y_end)
     {
         double scale_factor = length / NDomainLengthY;
 
-        for (int64_t y_idx = 0; y_idx < NDomainLengthY; ++y_idx)
+        for (int64_t y_idx = y_begin; y_idx < y_end; ++y_idx)
         for (int64_t x_idx = 0; x_idx < NDomainLengthX; ++x_idx)
         {
             double x = scale_factor * 
@@ -91,6 +102,17 @@ public:
         }
     }
 
+    /**
+     * @brief Reallocates storage leaving its pages untouched
+     * All the rows must be then initialized with init_rows(),
+     * so each page is placed on the NUMA node of the thread touching it.
+     */
+    void reset_untouched()
+    {
+        data_vec_ = decltype(data_vec_)();
+        data_vec_ = decltype(data_vec_)(NDomainLengthY * NDomainLengthX);
+    }
+
     template<typename TStream>
     TStream& dump(TStream& stream) const noexcept
     {
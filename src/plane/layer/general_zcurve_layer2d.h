@@ -162,7 +162,7 @@ public:
     //------------------------------------------------------------ 
 
     WmGeneralZCurveLayer2D():
-        data_vec_(NDomainLengthX * NDomainLengthY)
+        data_vec_(NDomainLengthX * NDomainLengthY, TData{})
     {}
 
     WmGeneralZCurveLayer2D
@@ -177,11 +177,25 @@ public:
 
     template<typename FInitFunc>
     void init(double length, FInitFunc func)
+    {
+        init_rows(length, func, 0, NDomainLengthY);
+    }
+
+    /**
+     * @brief Initializes rows [y_begin, y_end) only
+     * Rows may be initialized from different threads concurrently.
+     */
+    template<typename FInitFunc>
+    void init_rows(double length, FInitFunc&& func,
+                   int64_t y_begin, int64_t y_end)
     {
         double scale_factor = length / NDomainLengthY;
 
         int64_t row_idx = 0;
-        for (int64_t y_idx = 0; y_idx < NDomainLengthY; ++y_idx)
+        for (int64_t y_idx = 0; y_idx < y_begin; ++y_idx)
+            row_idx += off_bottom<0>(row_idx, 1);
+
+        for (int64_t y_idx = y_begin; y_idx < y_end; ++y_idx)
         {
             int64_t idx = row_idx;
             for (int64_t x_idx = 0; x_idx < NDomainLengthX; ++x_idx)
@@ -203,6 +217,17 @@ public:
         }
     }
 
+    /**
+     * @brief Reallocates storage leaving its pages untouched
+     * All the rows must be then initialized with init_rows(),
+     * so each page is placed on the NUMA node of the thread touching it.
+     */
+    void reset_untouched()
+    {
+        data_vec_ = decltype(data_vec_)();
+        data_vec_ = decltype(data_vec_)(NDomainLengthX * NDomainLengthY);
+    }
+
     template<typename TStream>
     TStream& dump(TStream& stream) const noexcept
     {
@@ -0,0 +1,234 @@
+#ifndef WAVE_MODEL_LOGGING_TRACE_H_
+#define WAVE_MODEL_LOGGING_TRACE_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <chrono>
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(WM_TRACE)
+    #define WM_TRACE_THREAD(NAME, IDX) \
+        WmTracer::name_thread((NAME), (IDX))
+
+    #define WM_TRACE_NODE(IDX, WINDOW, TYPE_X, TYPE_Y) \
+        WmTraceScope wm_trace_scope { \
+            "node", (IDX), (WINDOW), \
+            static_cast<int>(TYPE_X), static_cast<int>(TYPE_Y) \
+        }
+
+#else // defined(WM_TRACE)
+    #define WM_TRACE_THREAD(NAME, IDX) \
+        static_cast<void>(IDX)
+
+    #define WM_TRACE_NODE(IDX, WINDOW, TYPE_X, TYPE_Y)
+
+#endif // defined(WM_TRACE)
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Records timeline of the node executions
+ * Each thread appends events to its own buffer without any locking,
+ * only the first event of the thread registers its buffer.
+ * Timeline is dumped as Chrome trace JSON (opens in Perfetto)
+ * with one track per thread.
+ * Is used via WM_TRACE_* macros, which expand to nothing
+ * unless WM_TRACE is defined.
+ */
+class WmTracer
+{
+public:
+    // allow only namespace-like usage
+    WmTracer() = delete;
+
+    /// Number of events reserved per thread (to not reallocate on the run)
+    static constexpr size_t NReservedEvents = 1u << 16;
+
+    /// Executed node record
+    struct Event
+    {
+        const char* name;
+        int64_t start; ///< nanoseconds since tracer creation
+        int64_t end;
+        size_t idx; ///< node index
+        size_t window; ///< time window index
+        int type_x; ///< cell type by X (WmGeneralConeFoldTiling2D::EType)
+        int type_y;
+    };
+
+    /// Events of the single thread
+    struct Buffer
+    {
+        size_t tid;
+        std::string name;
+        std::vector<Event> events;
+    };
+
+    /**
+     * @brief Returns nanoseconds since tracer creation
+     */
+    static int64_t now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                TClock::now() - registry().epoch).count();
+    }
+
+    /**
+     * @brief Returns buffer of the calling thread
+     */
+    static Buffer& buffer()
+    {
+        thread_local Buffer* buffer = register_thread();
+        return *buffer;
+    }
+
+    /**
+     * @brief Names the track of the calling thread
+     * @param name Thread role (e.g. executor name)
+     * @param idx Thread index within its role
+     */
+    static void name_thread(const char* name, size_t idx)
+    {
+        buffer().name = std::string(name) + " " + std::to_string(idx);
+    }
+
+    /**
+     * @brief Drops all recorded events
+     * Must not be called concurrently with tracing.
+     */
+    static void clear()
+    {
+        std::unique_lock<std::mutex> lock(registry().mutex);
+        for (auto& buffer : registry().buffers)
+            buffer->events.clear();
+    }
+
+    /**
+     * @brief Writes recorded events as Chrome trace JSON
+     * Must not be called concurrently with tracing.
+     * @param stream Output stream
+     */
+    template<typename TStream>
+    static TStream& dump(TStream& stream)
+    {
+        static constexpr char NTypeNames[] = "ABCDN";
+
+        std::unique_lock<std::mutex> lock(registry().mutex);
+
+        const char* separator = "\n";
+        stream << "{\"traceEvents\":[";
+
+        for (const auto& buffer : registry().buffers)
+        {
+            stream << separator
+                   << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+                   << "\"tid\":" << buffer->tid << ","
+                   << "\"args\":{\"name\":\"" << buffer->name << "\"}}";
+            separator = ",\n";
+
+            for (const Event& event : buffer->events)
+            {
+                stream << separator
+                       << "{\"name\":\"" << event.name << "\",\"ph\":\"X\","
+                       << "\"pid\":0,\"tid\":" << buffer->tid << ",\"ts\":";
+                write_micros(stream, event.start);
+                stream << ",\"dur\":";
+                write_micros(stream, event.end - event.start);
+                stream << ",\"args\":{\"idx\":" << event.idx
+                       << ",\"window\":" << event.window
+                       << ",\"type\":\"" << NTypeNames[event.type_x]
+                       << NTypeNames[event.type_y] << "\"}}";
+            }
+        }
+
+        stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+        return stream;
+    }
+
+private:
+    using TClock = std::chrono::steady_clock;
+
+    /// Buffers of all threads ever traced
+    struct Registry
+    {
+        std::mutex mutex{};
+        std::vector<std::unique_ptr<Buffer>> buffers{};
+        TClock::time_point epoch = TClock::now();
+    };
+
+    static Registry& registry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /**
+     * @brief Creates buffer of the calling thread
+     * Buffers outlive their threads to be dumped after the run.
+     */
+    static Buffer* register_thread()
+    {
+        std::unique_lock<std::mutex> lock(registry().mutex);
+
+        size_t tid = registry().buffers.size();
+        registry().buffers.push_back(std::make_unique<Buffer>(
+                Buffer{ tid, "thread " + std::to_string(tid), {} }));
+        registry().buffers.back()->events.reserve(NReservedEvents);
+
+        return registry().buffers.back().get();
+    }
+
+    /**
+     * @brief Writes nanoseconds as microseconds with fraction
+     */
+    template<typename TStream>
+    static void write_micros(TStream& stream, int64_t nanos)
+    {
+        int64_t frac = nanos % 1000;
+
+        stream << nanos / 1000 << '.'
+               << static_cast<char>('0' + frac / 100)
+               << static_cast<char>('0' + frac / 10 % 10)
+               << static_cast<char>('0' + frac % 10);
+    }
+};
+
+/**
+ * @brief Records the event of its own lifetime
+ */
+class WmTraceScope
+{
+public:
+    WmTraceScope(const char* name, size_t idx, size_t window,
+                 int type_x, int type_y):
+        event_{ name, WmTracer::now(), 0, idx, window, type_x, type_y }
+    {}
+
+    WmTraceScope             (const WmTraceScope&) = delete;
+    WmTraceScope& operator = (const WmTraceScope&) = delete;
+
+    ~WmTraceScope()
+    {
+        event_.end = WmTracer::now();
+        WmTracer::buffer().events.push_back(event_);
+    }
+
+private:
+    WmTracer::Event event_;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_LOGGING_TRACE_H_
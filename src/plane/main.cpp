@@ -7,22 +7,54 @@
  */
 
 #include "test/parallel/thread_pool_executor_test.h"
+#include "test/parallel/work_stealing_executor_test.h"
+#include "test/parallel/dataflow_scheduler_test.h"
+#include "test/parallel/affinity_test.h"
+#include "test/parallel/numa_partition_test.h"
+#include "test/parallel/static_scheduler_test.h"
+#include "test/parallel/priority_executor_test.h"
+#include "test/parallel/graph_analyzer_test.h"
+#include "test/parallel/executor_metrics_test.h"
+#include "test/parallel/batch_runner_test.h"
+#include "test/parallel/node_splitter_test.h"
+#include "test/parallel/coroutine_scheduler_test.h"
+#include "test/parallel/hybrid_semaphore_test.h"
+#include "test/parallel/hybrid_mutex_test.h"
+#include "test/parallel/sync_array_test.h"
 #include "parallel/thread_pool_executor.h"
+#include "parallel/work_stealing_executor.h"
+#include "parallel/priority_executor.h"
 #include "parallel/sequential_executor.h"
+#include "parallel/batch_runner.h"
 #include "parallel/conefold_node2d.h"
 #include "parallel/conefold_grid2d.h"
 
 #include "general_solver2d.h"
 #include "parallel_solver2d.h"
+#include "parallel_diamondtorre_solver2d.h"
 #include "openmp_solver2d.h"
 #include "logging/macro.h"
 #include "logging/logger.h"
+#include "logging/trace.h"
 
 #include "layer/general_linear_layer2d.h"
 #include "layer/general_zcurve_layer2d.h"
 #include "stencil/basic_wave_stencil2d.h"
 #include "stencil/avx_axis_basic_wave_stencil2d.h"
 #include "stencil/avx_quad_basic_wave_stencil2d.h"
+#include "stencil/fma_axis_basic_wave_stencil2d.h"
+#include "stencil/fma_quad_basic_wave_stencil2d.h"
+#include "stencil/cpu_dispatch.h"
+#include "stencil/float_basic_wave_stencil2d.h"
+#include "stencil/avx_oct_basic_wave_stencil2d.h"
+#include "stencil/avx_oct_axis_basic_wave_stencil2d.h"
+#include "stencil/packed_basic_wave_stencil2d.h"
+#include "stencil/f16c_oct_basic_wave_stencil2d.h"
+#include "stencil/mixed_oct_basic_wave_stencil2d.h"
+#include "stencil/high_order_wave_stencil2d.h"
+#include "stencil/avx_high_order_wave_stencil2d.h"
+#include "stencil/velocity_wave_stencil2d.h"
+#include "stencil/avx_velocity_wave_stencil2d.h"
 #include "tiling/general_conefold_tiling2d.h"
 #include "tiling/general_diamondtorre_tiling2d.h"
 
@@ -38,6 +70,11 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <thread>
 
 /// @brief
 using namespace wave_model;
@@ -87,6 +124,7 @@ auto run_scalar(double length, double delta_time, size_t run_count)
         (length, delta_time, init_func);
 
     solver->advance(run_count);
+    // solver->advance_forked(run_count);
 
     return solver;
 }
@@ -96,18 +134,20 @@ auto run_scalar(double length, double delta_time, size_t run_count)
  *
  * Properties:
  * - Solver: general
- * - Stencil: Basic 2-order vectorized-by-axis with AVX
+ * - Stencil: Basic 2-order vectorized-by-axis with AVX (or AVX2 and FMA)
  * - Data: Linear
  * - Tiling: ConeFold
  * - Initial: Cosine hat
  *
  * @tparam NSideRank Rank of the domain side
  * @tparam NTileRank Rank of the tiling depth
+ * @tparam TStencil Stencil sharing WmAvxAxisBasicWaveData2D packing
  * @param length Domain length
  * @param delta_time Time discretization delta
  * @param run_count Number of layer calculation steps
  */
-template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2,
+         typename TStencil = WmAvxAxisBasicWaveStencil2D>
 auto run_vector_axis(double length, double delta_time, size_t run_count)
 {
     static_assert(!(NSideRank < NTileRank), "side must not be less than tile");
@@ -120,17 +160,17 @@ auto run_vector_axis(double length, double delta_time, size_t run_count)
         return { 
             // .intencity = 
             // TODO: to replace delta / 4 with more convenient interface
-                _mm256_setr_pd(init_wave(4.0 * x + 0.00 * delta, y), 
-                               init_wave(4.0 * x + 0.25 * delta, y), 
-                               init_wave(4.0 * x + 0.50 * delta, y), 
-                               init_wave(4.0 * x + 0.75 * delta, y)) 
+                { init_wave(4.0 * x + 0.00 * delta, y), 
+                  init_wave(4.0 * x + 0.25 * delta, y), 
+                  init_wave(4.0 * x + 0.50 * delta, y), 
+                  init_wave(4.0 * x + 0.75 * delta, y) } 
         }; 
     };
 
     auto solver = 
         std::make_unique<
             WmGeneralSolver2D<
-                WmAvxAxisBasicWaveStencil2D, 
+                TStencil, 
                 WmGeneralConeFoldTiling2D<
                     NTileRank
                     >, 
@@ -151,18 +191,20 @@ auto run_vector_axis(double length, double delta_time, size_t run_count)
  *
  * Properties:
  * - Solver: general
- * - Stencil: Basic 2-order vectorized-by-quad with AVX
+ * - Stencil: Basic 2-order vectorized-by-quad with AVX (or AVX2 and FMA)
  * - Data: Linear
  * - Tiling: ConeFold
  * - Initial: Cosine hat
  *
  * @tparam NSideRank Rank of the domain side
  * @tparam NTileRank Rank of the tiling depth
+ * @tparam TStencil Stencil sharing WmAvxQuadBasicWaveData2D packing
  * @param length Domain length
  * @param delta_time Time discretization delta
  * @param run_count Number of layer calculation steps
  */
-template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2,
+         typename TStencil = WmAvxQuadBasicWaveStencil2D>
 auto run_vector_quad(double length, double delta_time, size_t run_count)
 {
     static_assert(!(NSideRank < NTileRank), "side must not be less than tile");
@@ -175,17 +217,17 @@ auto run_vector_quad(double length, double delta_time, size_t run_count)
         return { 
             // .intencity = 
             // TODO: to replace delta / 4 with more convenient interface
-                _mm256_setr_pd(init_wave(x - 0.5 * delta, y - 0.5 * delta), 
-                               init_wave(x + 0.5 * delta, y - 0.5 * delta), 
-                               init_wave(x - 0.5 * delta, y + 0.5 * delta), 
-                               init_wave(x + 0.5 * delta, y + 0.5 * delta)) 
+                { init_wave(x - 0.5 * delta, y - 0.5 * delta), 
+                  init_wave(x + 0.5 * delta, y - 0.5 * delta), 
+                  init_wave(x - 0.5 * delta, y + 0.5 * delta), 
+                  init_wave(x + 0.5 * delta, y + 0.5 * delta) } 
         }; 
     };
 
     auto solver = 
         std::make_unique<
             WmGeneralSolver2D<
-                WmAvxQuadBasicWaveStencil2D, 
+                TStencil, 
                 WmGeneralConeFoldTiling2D<
                     NTileRank
                     >, 
@@ -201,6 +243,810 @@ auto run_vector_quad(double length, double delta_time, size_t run_count)
     return solver;
 }
 
+/**
+ * @brief Data packing of the vector stencils
+ */
+enum EVectorPacking
+{
+    PACKING_QUAD, ///< 2x2 cells of WmAvxQuadBasicWaveData2D
+    PACKING_AXIS  ///< 4 cells along x of WmAvxAxisBasicWaveData2D
+};
+
+/**
+ * @brief Runs vectorized computations with the best host kernel
+ *
+ * Properties:
+ * - Solver: general
+ * - Stencil: Basic 2-order, chosen by WmCpuDispatch at runtime
+ * - Data: the packing, the scalar one if no vector kernel fits the host
+ * - Tiling: ConeFold
+ * - Initial: Cosine hat
+ *
+ * Solvers of different kernels differ in type, 
+ * so the finished solver is passed to the generic functor.
+ *
+ * @tparam NSideRank Rank of the domain side
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ * @param packing Data packing of the vector kernels
+ * @param done_func Functor called with the solver after the run
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2, typename TFunc>
+void run_dispatched(double length, double delta_time, size_t run_count, 
+                    EVectorPacking packing, TFunc&& done_func)
+{
+    WmCpuDispatch::EIsa isa = WmCpuDispatch::select();
+    std::cerr << "Stencil kernel: " << WmCpuDispatch::name(isa) 
+              << (packing == PACKING_AXIS ? " axis" : " quad") << '\n';
+
+    switch (isa)
+    {
+        case WmCpuDispatch::ISA_AVX2_FMA:
+            if (packing == PACKING_AXIS)
+                done_func(*run_vector_axis<NSideRank, NTileRank,
+                                           WmFmaAxisBasicWaveStencil2D>
+                    (length, delta_time, run_count));
+            else
+                done_func(*run_vector_quad<NSideRank, NTileRank,
+                                           WmFmaQuadBasicWaveStencil2D>
+                    (length, delta_time, run_count));
+            break;
+
+        case WmCpuDispatch::ISA_AVX_F16C:
+        case WmCpuDispatch::ISA_AVX:
+            if (packing == PACKING_AXIS)
+                done_func(*run_vector_axis<NSideRank, NTileRank>
+                    (length, delta_time, run_count));
+            else
+                done_func(*run_vector_quad<NSideRank, NTileRank>
+                    (length, delta_time, run_count));
+            break;
+
+        default:
+            done_func(*run_scalar<NSideRank, NTileRank>
+                (length, delta_time, run_count));
+            break;
+    }
+}
+
+/**
+ * @brief Returns init functor of NCellsX x NCellsY cells packs
+ * Layers scale both pack coordinates by the pack height, 
+ * so x is stretched to keep the cells square.
+ * @tparam TData Packed data type
+ * @param wave Initial wave
+ * @param delta Cell side
+ */
+template<typename TData, typename TWave>
+auto make_packed_init(const TWave& wave, double delta)
+{
+    return [&wave, delta](double x, double y) -> TData
+    {
+        using TValue = std::remove_all_extents_t<decltype(TData::intencity)>;
+        static constexpr double NStretch = 
+            static_cast<double>(TData::NCellsX) / TData::NCellsY;
+
+        TData data = {};
+        for (size_t y_idx = 0; y_idx < TData::NCellsY; ++y_idx)
+        for (size_t x_idx = 0; x_idx < TData::NCellsX; ++x_idx)
+        {
+            data.intencity[y_idx * TData::NCellsX + x_idx] = 
+                static_cast<TValue>(wave(NStretch * x + x_idx * delta, 
+                                         y + y_idx * delta));
+        }
+
+        return data;
+    };
+}
+
+/**
+ * @brief Returns init functor of velocity packs
+ * Cells are placed as make_packed_init() places them.
+ * @tparam TVelocityData Velocity data type
+ * @param model Velocity of the medium at the point
+ * @param delta Cell side
+ */
+template<typename TVelocityData, typename TModel>
+auto make_velocity_init(const TModel& model, double delta)
+{
+    return [&model, delta](double x, double y) -> TVelocityData
+    {
+        static constexpr double NStretch = 
+            static_cast<double>(TVelocityData::NCellsX) / 
+            TVelocityData::NCellsY;
+
+        TVelocityData data = {};
+        for (size_t y_idx = 0; y_idx < TVelocityData::NCellsY; ++y_idx)
+        for (size_t x_idx = 0; x_idx < TVelocityData::NCellsX; ++x_idx)
+        {
+            data.velocity[y_idx * TVelocityData::NCellsX + x_idx] = 
+                model(NStretch * x + x_idx * delta, y + y_idx * delta);
+        }
+
+        return data;
+    };
+}
+
+/**
+ * @brief Returns the shared velocity layer of the stencil
+ * @param length Domain length
+ * @param model Velocity of the medium at the point
+ */
+template<typename TStencil, size_t NRankY, typename TModel>
+auto make_velocity_layer(double length, const TModel& model)
+{
+    using TVelocityLayer = typename TStencil::TVelocityLayer;
+    using TVelocityData = typename TStencil::TVelocityData;
+
+    double delta = length / (1u << NRankY) / TVelocityData::NCellsY;
+
+    auto velocity = std::make_shared<TVelocityLayer>();
+    velocity->init(length, 
+                   make_velocity_init<TVelocityData>(model, delta));
+
+    return std::shared_ptr<const TVelocityLayer>(std::move(velocity));
+}
+
+/**
+ * @brief Unpacks the layer into the row-major array of cells
+ * @param layer Linear or Z-order layer of scalar or packed data
+ */
+template<typename TLayer>
+std::vector<double> collect_cells(const TLayer& layer)
+{
+    using TData = typename TLayer::TData;
+    static constexpr bool NPacked = 
+        std::is_array_v<decltype(TData::intencity)>;
+
+    int64_t cells_x = 1;
+    int64_t cells_y = 1;
+    if constexpr (NPacked)
+    {
+        cells_x = TData::NCellsX;
+        cells_y = TData::NCellsY;
+    }
+
+    int64_t width = TLayer::NDomainLengthX * cells_x;
+    std::vector<double> cells(width * TLayer::NDomainLengthY * cells_y);
+
+    int64_t row_idx = 0;
+    for (int64_t y_idx = 0; y_idx < TLayer::NDomainLengthY; ++y_idx)
+    {
+        int64_t idx = row_idx;
+        for (int64_t x_idx = 0; x_idx < TLayer::NDomainLengthX; ++x_idx)
+        {
+            for (int64_t cell_y = 0; cell_y < cells_y; ++cell_y)
+            for (int64_t cell_x = 0; cell_x < cells_x; ++cell_x)
+            {
+                double value = 0.0;
+                if constexpr (NPacked)
+                    value = layer[idx].intencity[cell_y * cells_x + cell_x];
+                else
+                    value = layer[idx].intencity;
+
+                cells[(y_idx * cells_y + cell_y) * width + 
+                      x_idx * cells_x + cell_x] = value;
+            }
+
+            idx += TLayer::template off_right<0>(idx, 1);
+        }
+
+        row_idx += TLayer::template off_bottom<0>(row_idx, 1);
+    }
+
+    return cells;
+}
+
+/**
+ * @brief Runs single- or half-precision vectorized-by-oct computations
+ *
+ * Properties:
+ * - Solver: general
+ * - Stencil: Basic 2-order over 2x4 cells blocks (float, half or mixed)
+ * - Data: Linear
+ * - Tiling: ConeFold
+ * - Initial: Cosine hat
+ *
+ * @tparam NSideRank Rank of the domain side in cells
+ * @tparam NTileRank Rank of the tiling depth
+ * @tparam TStencil Stencil over 2x4 blocks (e.g. WmF16cOctBasicWaveStencil2D)
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2,
+         typename TStencil = WmAvxOctBasicWaveStencil2D>
+auto run_vector_oct(double length, double delta_time, size_t run_count)
+{
+    static_assert(!(NSideRank < NTileRank + 2), 
+                  "side must not be less than tile");
+
+    using TData = typename TStencil::TData;
+
+    double delta = length / (1u << (NSideRank - 2)) / TData::NCellsY;
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+    auto init_func = make_packed_init<TData>(init_wave, delta);
+
+    auto solver = 
+        std::make_unique<
+            WmGeneralSolver2D<
+                TStencil, 
+                WmGeneralConeFoldTiling2D<
+                    NTileRank
+                    >, 
+                WmGeneralLinearLayer2D, 
+                NSideRank - 2, 
+                NSideRank - 2
+                > 
+            >
+        (length, delta_time, init_func);
+
+    solver->advance(run_count);
+
+    return solver;
+}
+
+/**
+ * @brief Runs general solver from the wave and returns resulting cells
+ * Packed data is initialized cell by cell, 
+ * stencil_args are passed to the stencil.
+ */
+template<typename TStencil, 
+         template<typename, size_t, size_t> typename TLayer, 
+         size_t NRankX, size_t NRankY, size_t NTileRank, typename TWave,
+         typename... TStencilArgs>
+std::vector<double> run_cells(double length, double delta_time, 
+                              size_t run_count, const TWave& wave,
+                              const TStencilArgs&... stencil_args)
+{
+    using TData = typename TStencil::TData;
+    using TValue = std::remove_all_extents_t<decltype(TData::intencity)>;
+
+    auto run = [&](auto&& init_func)
+    {
+        auto solver = 
+            std::make_unique<
+                WmGeneralSolver2D<
+                    TStencil, 
+                    WmGeneralConeFoldTiling2D<
+                        NTileRank
+                        >, 
+                    TLayer, 
+                    NRankX, 
+                    NRankY
+                    > 
+                >
+            (length, delta_time, init_func, stencil_args...);
+
+        solver->advance(run_count);
+
+        return collect_cells(solver->layer());
+    };
+
+    if constexpr (std::is_array_v<decltype(TData::intencity)>)
+    {
+        double delta = length / (1u << NRankY) / TData::NCellsY;
+        return run(make_packed_init<TData>(wave, delta));
+    }
+    else
+    {
+        return run([&wave](double x, double y) -> TData
+                   { 
+                       return { static_cast<TValue>(wave(x, y)) }; 
+                   });
+    }
+}
+
+/**
+ * @brief Prints the maximal and the relative L2 differences of the cells
+ */
+void report_diff(const char* name, const std::vector<double>& cells, 
+                 const std::vector<double>& reference)
+{
+    double max_diff = 0.0;
+    double diff_norm2 = 0.0;
+    double reference_norm2 = 0.0;
+
+    for (size_t idx = 0; idx < cells.size(); ++idx)
+    {
+        double diff = cells[idx] - reference[idx];
+
+        max_diff = std::max(max_diff, std::abs(diff));
+        diff_norm2 += diff * diff;
+        reference_norm2 += reference[idx] * reference[idx];
+    }
+
+    std::cerr << name << ": max |diff| " << max_diff 
+              << " relative L2 " 
+              << std::sqrt(diff_norm2 / reference_norm2) << '\n';
+}
+
+/**
+ * @brief Compares single-precision stencils with the double ones
+ *
+ * The stencils update the cells in place, so the results depend on
+ * the order of updates and each float stencil is compared with
+ * the double one of the same traversal and block shape: the scalar
+ * stencil on 2^NSideRank x 2^NSideRank cells and both AVX oct packings
+ * (2x4 and 1x8 cells) on square grids of 2^(NSideRank - 2) blocks,
+ * as ConeFold tiling covers only square grids evenly.
+ * AVX packings must be bitwise equal to the portable float ones
+ * unless the math is reassociated (e.g. by -Ofast),
+ * Z-order layers must be bitwise equal to the linear ones.
+ *
+ * @tparam NSideRank Rank of the scalar domain side
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+void run_float_accuracy(double length, double delta_time, size_t run_count)
+{
+    static_assert(NTileRank + 2 <= NSideRank, "blocks must fit the tiling");
+
+    if (!WmCpuDispatch::supports(WmCpuDispatch::ISA_AVX))
+    {
+        std::cerr << "Float accuracy: AVX is not supported\n";
+        return;
+    }
+
+    static constexpr size_t NBlockRank = NSideRank - 2;
+
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+
+    using TOct = WmAvxOctBasicWaveStencil2D;
+    using TOctAxis = WmAvxOctAxisBasicWaveStencil2D;
+
+    report_diff("float scalar vs double", 
+                run_cells<WmFloatBasicWaveStencil2D, WmGeneralLinearLayer2D, 
+                          NSideRank, NSideRank, NTileRank>
+                    (length, delta_time, run_count, init_wave),
+                run_cells<WmBasicWaveStencil2D, WmGeneralLinearLayer2D, 
+                          NSideRank, NSideRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+
+    auto oct = 
+        run_cells<TOct, WmGeneralLinearLayer2D, 
+                  NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave);
+    report_diff("float oct 2x4 vs double", oct, 
+                run_cells<WmPackedBasicWaveStencil2D<double, 4, 2>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("float oct 2x4 vs portable", oct, 
+                run_cells<WmPackedBasicWaveStencil2D<float, 4, 2>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("float oct 2x4 z-order vs linear", 
+                run_cells<TOct, WmGeneralZCurveLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave), 
+                oct);
+
+    auto oct_axis = 
+        run_cells<TOctAxis, WmGeneralLinearLayer2D, 
+                  NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave);
+    report_diff("float oct 1x8 vs double", oct_axis, 
+                run_cells<WmPackedBasicWaveStencil2D<double, 8, 1>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("float oct 1x8 vs portable", oct_axis, 
+                run_cells<WmPackedBasicWaveStencil2D<float, 8, 1>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("float oct 1x8 z-order vs linear", 
+                run_cells<TOctAxis, WmGeneralZCurveLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave), 
+                oct_axis);
+}
+
+/**
+ * @brief Compares half-precision storage with the float and double one
+ *
+ * Runs the F16C stencil storing both time layers in half precision
+ * and the mixed one keeping the odd layers in float on square grids
+ * of 2^(NSideRank - 2) blocks of 2x4 cells, compares them with
+ * the double and the float stencils of the same block shape.
+ * F16C stencil must be bitwise equal to the portable one,
+ * Z-order layers must be bitwise equal to the linear ones.
+ *
+ * @tparam NSideRank Rank of the scalar domain side
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+void run_half_accuracy(double length, double delta_time, size_t run_count)
+{
+    static_assert(NTileRank + 2 <= NSideRank, "blocks must fit the tiling");
+    static_assert(NTileRank > 0, "mixed layers need the even tiling depth");
+
+    if (!WmCpuDispatch::supports(WmCpuDispatch::ISA_AVX_F16C))
+    {
+        std::cerr << "Half accuracy: F16C is not supported\n";
+        return;
+    }
+
+    static constexpr size_t NBlockRank = NSideRank - 2;
+
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+
+    using THalf = WmF16cOctBasicWaveStencil2D;
+    using TMixed = WmMixedOctBasicWaveStencil2D;
+
+    auto exact = 
+        run_cells<WmPackedBasicWaveStencil2D<double, 4, 2>, 
+                  WmGeneralLinearLayer2D, 
+                  NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave);
+    auto single = 
+        run_cells<WmAvxOctBasicWaveStencil2D, WmGeneralLinearLayer2D, 
+                  NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave);
+
+    auto half = 
+        run_cells<THalf, WmGeneralLinearLayer2D, 
+                  NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave);
+    report_diff("half 2x4 vs double", half, exact);
+    report_diff("half 2x4 vs float", half, single);
+    report_diff("half 2x4 vs portable", half, 
+                run_cells<WmPackedBasicWaveStencil2D<float, 4, 2, WmHalf>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("half 2x4 z-order vs linear", 
+                run_cells<THalf, WmGeneralZCurveLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave), 
+                half);
+
+    auto mixed = 
+        run_cells<TMixed, WmGeneralLinearLayer2D, 
+                  NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave);
+    report_diff("mixed 2x4 vs double", mixed, exact);
+    report_diff("mixed 2x4 vs float", mixed, single);
+    report_diff("mixed 2x4 z-order vs linear", 
+                run_cells<TMixed, WmGeneralZCurveLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave), 
+                mixed);
+}
+
+/**
+ * @brief Runs vectorized high-order computations
+ *
+ * Properties:
+ * - Solver: general
+ * - Stencil: Order 2 * NRadius over 4x4 cells blocks with AVX
+ * - Data: Linear
+ * - Tiling: ConeFold with the slope of 4 cells
+ * - Initial: Cosine hat
+ *
+ * @tparam NSideRank Rank of the domain side in cells
+ * @tparam NTileRank Rank of the tiling depth
+ * @tparam NRadius Stencil radius from 1 to 4
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2, 
+         size_t NRadius = 2>
+auto run_high_order(double length, double delta_time, size_t run_count)
+{
+    static_assert(!(NSideRank < NTileRank + 2), 
+                  "side must not be less than tile");
+
+    using TStencil = WmAvxHighOrderWaveStencil2D<NRadius>;
+    using TData = typename TStencil::TData;
+
+    double delta = length / (1u << (NSideRank - 2)) / TData::NCellsY;
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+    auto init_func = make_packed_init<TData>(init_wave, delta);
+
+    auto solver = 
+        std::make_unique<
+            WmGeneralSolver2D<
+                TStencil, 
+                WmGeneralConeFoldTiling2D<
+                    NTileRank
+                    >, 
+                WmGeneralLinearLayer2D, 
+                NSideRank - 2, 
+                NSideRank - 2
+                > 
+            >
+        (length, delta_time, init_func);
+
+    solver->advance(run_count);
+
+    return solver;
+}
+
+/**
+ * @brief Returns the maximal error of the second derivative of sine
+ * @tparam NRadius Radius of the central differences
+ * @param delta Grid step
+ */
+template<size_t NRadius>
+double second_derivative_error(double delta)
+{
+    static constexpr size_t NPointsCnt = 64;
+    static constexpr const double* NCoeffs = 
+        WmHighOrderCoeffs<NRadius>::NCoeffs;
+
+    double max_error = 0.0;
+    for (size_t point = 0; point < NPointsCnt; ++point)
+    {
+        double x = 6.0 * point / NPointsCnt;
+
+        double sum = NCoeffs[0] * std::sin(x);
+        for (size_t dist = 1; dist <= NRadius; ++dist)
+        {
+            sum += NCoeffs[dist] * 
+                (std::sin(x + dist * delta) + std::sin(x - dist * delta));
+        }
+
+        max_error = std::max(max_error, 
+                             std::abs(sum / (delta * delta) + std::sin(x)));
+    }
+
+    return max_error;
+}
+
+/**
+ * @brief Checks the high-order stencils
+ *
+ * Reports the error of the central differences at the grid steps
+ * h and h / 2 with the observed order log2(e(h) / e(h / 2)),
+ * which must be close to 2 * NRadius. 
+ * Compares the portable stencil of radius 1 over single cells with 
+ * WmBasicWaveStencil2D and the AVX stencils with the portable ones 
+ * over 4x4 blocks: all of them must be bitwise equal.
+ *
+ * @tparam NSideRank Rank of the domain side in cells
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+void run_high_order_accuracy(double length, double delta_time, 
+                             size_t run_count)
+{
+    static_assert(NTileRank + 2 <= NSideRank, "blocks must fit the tiling");
+
+    static constexpr size_t NBlockRank = NSideRank - 2;
+
+    auto report_order = [](size_t radius, double error, double half_error)
+    {
+        std::cerr << "radius " << radius << " error " << error 
+                  << " -> " << half_error << " order " 
+                  << std::log2(error / half_error) << '\n';
+    };
+
+    report_order(1, second_derivative_error<1>(0.2), 
+                    second_derivative_error<1>(0.1));
+    report_order(2, second_derivative_error<2>(0.2), 
+                    second_derivative_error<2>(0.1));
+    report_order(3, second_derivative_error<3>(0.2), 
+                    second_derivative_error<3>(0.1));
+    report_order(4, second_derivative_error<4>(0.2), 
+                    second_derivative_error<4>(0.1));
+
+    if (!WmCpuDispatch::supports(WmCpuDispatch::ISA_AVX))
+    {
+        std::cerr << "High order: AVX is not supported\n";
+        return;
+    }
+
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+
+    report_diff("radius 1 vs basic", 
+                run_cells<WmHighOrderWaveStencil2D<1>, WmGeneralLinearLayer2D, 
+                          NSideRank, NSideRank, NTileRank>
+                    (length, delta_time, run_count, init_wave),
+                run_cells<WmBasicWaveStencil2D, WmGeneralLinearLayer2D, 
+                          NSideRank, NSideRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+
+    report_diff("avx radius 1 vs portable", 
+                run_cells<WmAvxHighOrderWaveStencil2D<1>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave),
+                run_cells<WmHighOrderWaveStencil2D<1, 4, 4>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("avx radius 2 vs portable", 
+                run_cells<WmAvxHighOrderWaveStencil2D<2>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave),
+                run_cells<WmHighOrderWaveStencil2D<2, 4, 4>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("avx radius 3 vs portable", 
+                run_cells<WmAvxHighOrderWaveStencil2D<3>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave),
+                run_cells<WmHighOrderWaveStencil2D<3, 4, 4>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("avx radius 4 vs portable", 
+                run_cells<WmAvxHighOrderWaveStencil2D<4>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave),
+                run_cells<WmHighOrderWaveStencil2D<4, 4, 4>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+    report_diff("avx radius 4 z-order vs linear", 
+                run_cells<WmAvxHighOrderWaveStencil2D<4>, 
+                          WmGeneralZCurveLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave),
+                run_cells<WmAvxHighOrderWaveStencil2D<4>, 
+                          WmGeneralLinearLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+}
+
+/**
+ * @brief Runs vectorized computations in the heterogeneous medium
+ *
+ * Properties:
+ * - Solver: general
+ * - Stencil: Velocity one over 4x4 cells blocks with AVX
+ * - Data: Z-order, velocities share the layout
+ * - Tiling: ConeFold
+ * - Initial: Cosine hat in two layers of the velocities 1 and 0.5
+ *
+ * @tparam NSideRank Rank of the domain side in cells
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+auto run_velocity(double length, double delta_time, size_t run_count)
+{
+    static_assert(!(NSideRank < NTileRank + 2), 
+                  "side must not be less than tile");
+
+    static constexpr size_t NRank = NSideRank - 2;
+
+    using TStencil = WmAvxVelocityWaveStencil2D<WmGeneralZCurveLayer2D, NRank>;
+    using TData = typename TStencil::TData;
+
+    double delta = length / (1u << NRank) / TData::NCellsY;
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+    auto init_func = make_packed_init<TData>(init_wave, delta);
+
+    auto model = [](double, double y) { return y < 0.0 ? 1.0 : 0.5; };
+    auto velocity = make_velocity_layer<TStencil, NRank>(length, model);
+
+    auto solver = 
+        std::make_unique<
+            WmGeneralSolver2D<
+                TStencil, 
+                WmGeneralConeFoldTiling2D<
+                    NTileRank
+                    >, 
+                WmGeneralZCurveLayer2D, 
+                NRank, 
+                NRank
+                > 
+            >
+        (length, delta_time, init_func, velocity);
+
+    solver->advance(run_count);
+
+    return solver;
+}
+
+/**
+ * @brief Checks the velocity stencils
+ *
+ * The portable stencil in the medium of the velocity 1 must be bitwise
+ * equal to WmBasicWaveStencil2D, the AVX one to the portable one over
+ * 4x4 blocks in the layered medium. Two solvers running concurrently 
+ * on the same velocity layer must be equal to the single one.
+ *
+ * @tparam NSideRank Rank of the domain side in cells
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+void run_velocity_accuracy(double length, double delta_time, 
+                           size_t run_count)
+{
+    static_assert(NTileRank + 2 <= NSideRank, "blocks must fit the tiling");
+
+    static constexpr size_t NBlockRank = NSideRank - 2;
+
+    using TUniform = 
+        WmVelocityWaveStencil2D<WmGeneralLinearLayer2D, NSideRank>;
+    using TPortable = 
+        WmVelocityWaveStencil2D<WmGeneralZCurveLayer2D, 
+                                NBlockRank, NBlockRank, 4, 4>;
+    using TAvx = 
+        WmAvxVelocityWaveStencil2D<WmGeneralZCurveLayer2D, NBlockRank>;
+
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+
+    auto uniform = [](double, double) { return 1.0; };
+    auto layered = [](double, double y) { return y < 0.0 ? 1.0 : 0.5; };
+
+    report_diff("velocity 1 vs basic", 
+                run_cells<TUniform, WmGeneralLinearLayer2D, 
+                          NSideRank, NSideRank, NTileRank>
+                    (length, delta_time, run_count, init_wave, 
+                     make_velocity_layer<TUniform, NSideRank>
+                        (length, uniform)),
+                run_cells<WmBasicWaveStencil2D, WmGeneralLinearLayer2D, 
+                          NSideRank, NSideRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+
+    auto portable_velocity = 
+        make_velocity_layer<TPortable, NBlockRank>(length, layered);
+    auto portable = 
+        run_cells<TPortable, WmGeneralZCurveLayer2D, 
+                  NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave, portable_velocity);
+
+    report_diff("layered vs uniform", portable,
+                run_cells<WmPackedBasicWaveStencil2D<double, 4, 4>, 
+                          WmGeneralZCurveLayer2D, 
+                          NBlockRank, NBlockRank, NTileRank>
+                    (length, delta_time, run_count, init_wave));
+
+    if (!WmCpuDispatch::supports(WmCpuDispatch::ISA_AVX))
+    {
+        std::cerr << "Velocity: AVX is not supported\n";
+        return;
+    }
+
+    auto avx_velocity = 
+        make_velocity_layer<TAvx, NBlockRank>(length, layered);
+    auto run_avx = [&]
+    {
+        return run_cells<TAvx, WmGeneralZCurveLayer2D, 
+                         NBlockRank, NBlockRank, NTileRank>
+            (length, delta_time, run_count, init_wave, avx_velocity);
+    };
+
+    auto avx = run_avx();
+    report_diff("avx layered vs portable", avx, portable);
+
+    // the layer is shared by the solvers, not copied
+    std::vector<double> shared_cells[2];
+    std::thread shared_thread([&] { shared_cells[1] = run_avx(); });
+    shared_cells[0] = run_avx();
+    shared_thread.join();
+
+    report_diff("avx shared 0 vs single", shared_cells[0], avx);
+    report_diff("avx shared 1 vs single", shared_cells[1], avx);
+}
+
 /**
  * @brief Runs distributed-grid computations
  *
@@ -251,13 +1097,85 @@ auto run_parallel(double length, double delta_time, size_t run_count)
 
     // TODO: to fix parallel execution
     WmThreadPoolExecutor executor(4);
+    // WmWorkStealingExecutor executor(4);
+    // WmPriorityExecutor executor(4);
     // WmSequentialExecutor executor;
 
+    // solver->analyze().report(std::cout, 16);
     solver->advance(executor, run_count);
+    // solver->advance_pipelined(executor, run_count);
+    // solver->advance_static(4, run_count);
+    // solver->advance_coroutine(executor, run_count); // needs WM_COROUTINES
+
+    executor.metrics().report(std::cerr);
 
     return solver;
 }
 
+/**
+ * @brief Runs batch of independent distributed-grid computations
+ *
+ * Properties:
+ * - Solver: parallel, batch of jobs sharing one executor
+ * - Stencil: Basic 2-order scalar
+ * - Data: Z-order
+ * - Tiling: ConeFold
+ * - Initial: Cosine hat of the job's amplitude
+ *
+ * @tparam NSideRank Rank of the domain side
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps of each job
+ * @param jobs_count Number of jobs
+ * @return Sum of the jobs' values at the first point
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+double run_parallel_batch(double length, double delta_time, size_t run_count,
+                          size_t jobs_count)
+{
+    static_assert(!(NSideRank < NTileRank), "side must not be less than tile");
+
+    using TSolver = 
+        WmParallelSolver2D<
+            WmConeFoldGrid2D<
+                WmGeneralZCurveLayer2D<
+                    WmBasicWaveData2D, 
+                    NSideRank
+                    >, 
+                WmBasicWaveStencil2D, 
+                WmGeneralConeFoldTiling2D<
+                    NTileRank
+                    >, 
+                NTileRank
+                >
+            >;
+
+    WmThreadPoolExecutor executor(4);
+
+    // twice as many jobs in flight as workers to hide the window tails
+    WmBatchRunner<TSolver> runner(executor, 8, length, delta_time);
+
+    double checksum = 0.0;
+    runner.run(jobs_count, run_count, 
+        [](size_t job_idx, TSolver& solver) {
+            WmCosineHatWave2D init_wave { 
+                /* .ampl = */ 1.0 + static_cast<double>(job_idx), 
+                /* .freq = */ 0.5 
+            };
+
+            solver.reset([&init_wave](double x, double y) 
+                -> WmBasicWaveData2D { return { init_wave(x, y) }; });
+        },
+        [&checksum](size_t, const TSolver& solver) {
+            checksum += solver.layer()[0].intencity;
+        });
+
+    executor.metrics().report(std::cerr);
+
+    return checksum;
+}
+
 /**
  * @brief Runs distributed-grid computations with AVX
  *
@@ -287,10 +1205,10 @@ auto run_parallel_avx(double length, double delta_time, size_t run_count)
         return { 
             // .intencity = 
             // TODO: to replace delta / 4 with more convenient interface
-                _mm256_setr_pd(init_wave(x - 0.5 * delta, y - 0.5 * delta), 
-                               init_wave(x + 0.5 * delta, y - 0.5 * delta), 
-                               init_wave(x - 0.5 * delta, y + 0.5 * delta), 
-                               init_wave(x + 0.5 * delta, y + 0.5 * delta)) 
+                { init_wave(x - 0.5 * delta, y - 0.5 * delta), 
+                  init_wave(x + 0.5 * delta, y - 0.5 * delta), 
+                  init_wave(x - 0.5 * delta, y + 0.5 * delta), 
+                  init_wave(x + 0.5 * delta, y + 0.5 * delta) } 
         }; 
     };
 
@@ -314,10 +1232,70 @@ auto run_parallel_avx(double length, double delta_time, size_t run_count)
 
     // TODO: to fix parallel execution
     WmThreadPoolExecutor executor(4);
+    // WmWorkStealingExecutor executor(4);
+    // WmPriorityExecutor executor(4);
     // WmSequentialExecutor executor;
 
+    solver->advance(executor, run_count);
+    // solver->advance_pipelined(executor, run_count);
+    // solver->advance_static(4, run_count);
+
+    executor.metrics().report(std::cerr);
+
+    return solver;
+}
+
+/**
+ * @brief Runs pipelined DiamondTorre computations
+ *
+ * Properties:
+ * - Solver: parallel DiamondTorre
+ * - Stencil: Basic 2-order scalar
+ * - Data: Z-order
+ * - Tiling: DiamondTorre
+ * - Initial: Cosine hat
+ *
+ * @tparam NSideRank Rank of the domain side
+ * @tparam NTileRank Rank of the tiling depth
+ * @param length Domain length
+ * @param delta_time Time discretization delta
+ * @param run_count Number of layer calculation steps
+ */
+template<size_t NSideRank, size_t NTileRank = NSideRank - 2>
+auto run_parallel_diamondtorre(double length, double delta_time,
+                               size_t run_count)
+{
+    static_assert(!(NSideRank < NTileRank), "side must not be less than tile");
+
+    WmCosineHatWave2D init_wave { /* .ampl = */ 1.0, /* .freq = */ 0.5 };
+    auto init_func = [&init_wave](double x, double y) -> WmBasicWaveData2D
+    { 
+        return { 
+            // .intencity = 
+            init_wave(x, y) 
+        }; 
+    };
+
+    auto solver = 
+        std::make_unique<
+            WmParallelDiamondTorreSolver2D<
+                WmBasicWaveStencil2D, 
+                WmGeneralDiamondTorreTiling2D<
+                    NTileRank
+                    >, 
+                WmGeneralZCurveLayer2D, 
+                NSideRank, NSideRank
+                >
+            >
+        (length, delta_time, init_func);
+
+    WmWorkStealingExecutor executor(4);
+    // WmThreadPoolExecutor executor(4);
+
     solver->advance(executor, run_count);
 
+    executor.metrics().report(std::cerr);
+
     return solver;
 }
 
@@ -392,6 +1370,20 @@ template<typename TStream>
 TStream& test_parallel(TStream& stream)
 {
     wm_test_thread_pool_executor(stream);
+    wm_test_work_stealing_executor(stream);
+    wm_test_dataflow_scheduler(stream);
+    wm_test_affinity(stream);
+    wm_test_numa_partition(stream);
+    wm_test_static_scheduler(stream);
+    wm_test_priority_executor(stream);
+    wm_test_graph_analyzer(stream);
+    wm_test_executor_metrics(stream);
+    wm_test_batch_runner(stream);
+    wm_test_node_splitter(stream);
+    wm_test_coroutine_scheduler(stream);
+    wm_test_hybrid_semaphore(stream);
+    wm_test_hybrid_mutex(stream);
+    wm_test_sync_array(stream);
 
     return stream;
 }
@@ -423,14 +1415,39 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
     auto solver = run_scalar      <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
     // auto solver = run_parallel    <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
     // auto solver = run_parallel_avx<NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
+    // run_parallel_batch<NSideRank, NTileRank>(1e2, 0.1, NRunCnt, 64);
+    // run_dispatched    <NSideRank, NTileRank>(1e2, 0.1, NRunCnt, 
+    //                                         PACKING_QUAD, 
+    //                                         [](const auto&) {});
+    // run_float_accuracy<NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
+    // run_half_accuracy <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
+    // run_high_order_accuracy<NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
+    // run_velocity_accuracy  <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
     // auto solver = run_openmp      <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
+    // auto solver = 
+    //     run_parallel_diamondtorre<NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
     // auto solver = run_vector_quad <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
     // auto solver = run_vector_axis <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
+    // auto solver = run_vector_oct  <NSideRank, NTileRank, 
+    //                                WmF16cOctBasicWaveStencil2D>
+    //     (1e2, 0.1, NRunCnt);
+    // auto solver = run_vector_oct  <NSideRank, NTileRank, 
+    //                                WmMixedOctBasicWaveStencil2D>
+    //     (1e2, 0.1, NRunCnt);
+    // auto solver = run_high_order  <NSideRank, NTileRank, 4>
+    //     (1e2, 0.1, NRunCnt);
+    // auto solver = run_velocity    <NSideRank, NTileRank>(1e2, 0.1, NRunCnt);
 
 #if !defined(WM_BENCHMARK)
     solver->layer().dump(out_stream);
 
 #endif // defined(WM_BENCHMARK)
 
+#if defined(WM_TRACE)
+    std::ofstream trace_stream("trace.json");
+    WmTracer::dump(trace_stream);
+
+#endif // defined(WM_TRACE)
+
     return 0;
 }
@@ -7,6 +7,9 @@
  * @version 2.0
  */
 
+#include <new>
+#include <type_traits>
+
 #include <cstdlib>
 
 /// @brief
@@ -68,6 +71,20 @@ public:
         return std::free(ptr);
     }
 
+    /**
+     * @brief Default-initializes object (trivial ones are left untouched)
+     * Lets freshly allocated pages be first touched by the threads
+     * that are going to use them (see NUMA first-touch policy).
+     * Construction with arguments falls back to the placement new.
+     * @param ptr Pointer to the object memory
+     */
+    template<typename U>
+    void construct(U* ptr)
+        noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new (static_cast<void*>(ptr)) U;
+    }
+
 private:
 };
 
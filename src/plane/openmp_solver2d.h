@@ -8,15 +8,20 @@
  */
 
 #include "logging/macro.h"
+#include "logging/trace.h"
 
 #include "parallel/grid_graph.h"
-#include "parallel/openmp_mutex.h"
 
 #include <vector>
+#include <array>
 #include <algorithm>
 
 #include <cstdint>
 
+#if defined(_OPENMP)
+    #include <omp.h>
+#endif // _OPENMP
+
 /// @brief
 namespace wave_model {
 
@@ -45,6 +50,9 @@ public:
     static constexpr size_t NSizeY = TLayer::NDomainLengthY;
     static constexpr size_t NMod = TStencil::NMod;
 
+    /// Maximal number of dependencies of the grid node
+    static constexpr size_t NMaxDependencies = 3;
+
     static_assert(NMod > 0, "NMod must be positive");
 
 /*
@@ -60,22 +68,65 @@ public:
         length_(length),
         stencil_(length_ / NSizeY, dtime),
         grid_(layers_arr_, stencil_),
-        grid_graph_(grid_.build_graph())
-    {}
+        grid_graph_(grid_.build_graph()),
+        dependencies_(TGrid::NNodes),
+        tokens_(TGrid::NNodes + 1, 0)
+    {
+        // missing dependencies refer to the token no task ever writes
+        for (size_t idx = 0; idx < TGrid::NNodes; ++idx)
+        {
+            auto dependencies = grid_graph_.dependencies(idx);
+
+            WM_ASSERT(dependencies.size() <= NMaxDependencies,
+                      "too many dependencies");
+
+            dependencies_[idx].fill(TGrid::NNodes);
+            std::copy(std::begin(dependencies), std::end(dependencies),
+                      std::begin(dependencies_[idx]));
+        }
+    }
 
     /**
      * @brief Ctor from domain length, time delta and initial state function
      * @tparam TInitFunc Initial state function type
      * @param length Domain length
      * @param dtime Time delta
-     * @param init_func Initial state function
+     * @param init_func Initial state function (called concurrently)
      */
     template<typename TInitFunc>
     WmOpenMPSolver2D(double length, double dtime, TInitFunc&& init_func):
         WmOpenMPSolver2D(length, dtime)
     {
-        layers_arr_[NMod - 1]
-            .init(length_, std::forward<TInitFunc>(init_func));
+        using TData = typename TLayer::TData;
+
+        for (TLayer& layer : layers_arr_)
+            layer.reset_untouched();
+
+        // rows are first touched by strips: with OMP_PROC_BIND=spread
+        // each socket gets pages of its own part of the domain
+        #pragma omp parallel
+        {
+#if defined(_OPENMP)
+            int64_t strip_cnt = omp_get_num_threads();
+            int64_t strip_idx = omp_get_thread_num();
+#else // _OPENMP
+            int64_t strip_cnt = 1;
+            int64_t strip_idx = 0;
+#endif // _OPENMP
+
+            int64_t y_begin = NSizeY * strip_idx / strip_cnt;
+            int64_t y_end = NSizeY * (strip_idx + 1) / strip_cnt;
+
+            for (size_t layer_idx = 0; layer_idx < NMod - 1; ++layer_idx)
+            {
+                layers_arr_[layer_idx].init_rows(length_,
+                        [](double, double) { return TData{}; },
+                        y_begin, y_end);
+            }
+
+            layers_arr_[NMod - 1].init_rows(length_, init_func,
+                                            y_begin, y_end);
+        }
     }
 
     /**
@@ -89,34 +140,43 @@ public:
 
     /**
      * @brief Executes proc_cnt calculation steps
-     * @param executor Object to execute grid nodes
+     * Grid nodes are spawned as OpenMP tasks in grid order, graph edges
+     * are expressed with depend clauses on per-node tokens,
+     * so the runtime starts the node when its dependencies are done.
      * @param proc_cnt Number of steps to do
      */
     void advance(size_t proc_cnt)
     {
         static constexpr size_t NShift = (1u << NTileRank) % NMod;
 
+        char* tokens = tokens_.data();
+
         size_t proc_idx = 0;
         for (; proc_idx < proc_cnt; proc_idx += (1u << NTileRank))
         {
-            // make computations in grid order
-            #pragma omp parallel for schedule(dynamic,1)
-            for (auto it = std::begin(grid_graph_.order); 
-                 it != std::end(grid_graph_.order); ++it)
+            // grid order is topological as depend clauses require
+            #pragma omp parallel
+            #pragma omp single
+            for (size_t idx : grid_graph_.order)
             {
-                size_t idx = *it;
-
-                for (size_t affect : grid_graph_.graph[idx])
-                    mutexes_[affect].lock();
-
-                mutexes_[idx].lock();
-                grid_.access_node(idx)->execute();
-                mutexes_[idx].unlock();
-
-                for (size_t affect : grid_graph_.graph[idx])
-                    mutexes_[affect].unlock();
+                size_t dep0 = dependencies_[idx][0];
+                size_t dep1 = dependencies_[idx][1];
+                size_t dep2 = dependencies_[idx][2];
+
+                #pragma omp task firstprivate(idx) \
+                    depend(in: tokens[dep0], tokens[dep1], tokens[dep2]) \
+                    depend(out: tokens[idx])
+                {
+                    auto* node = grid_.access_node(idx);
+                    WM_TRACE_NODE(idx, window_idx_,
+                                  node->type_x(), node->type_y());
+
+                    node->execute();
+                }
             }
 
+            ++window_idx_;
+
             // rotate right to emulate dynamic programming 
             // with limited memory
             std::rotate(std::rbegin(layers_arr_), 
@@ -137,7 +197,9 @@ private:
     TStencil stencil_;
     TGrid grid_;
     WmGridGraph grid_graph_;
-    WmOpenMPMutex mutexes_[TGrid::NNodes];
+    std::vector<std::array<size_t, NMaxDependencies>> dependencies_;
+    std::vector<char> tokens_;
+    size_t window_idx_ = 0; ///< index of the next window to process
     TLayer layers_arr_[NMod];
 };
 
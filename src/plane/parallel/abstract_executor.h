@@ -7,8 +7,14 @@
  * @version 2.0
  */
 
+#include "task.h"
+#include "completion.h"
+#include "executor_metrics.h"
+
 #include <functional>
 
+#include <cstddef>
+
 /// @brief
 namespace wave_model {
 
@@ -28,6 +34,53 @@ public:
      */
     virtual void enqueue(std::function<void()> task) = 0;
 
+    /**
+     * @brief Enqueues preallocated task record to execute
+     * Default implementation wraps the record into std::function 
+     * (small enough to be stored without allocation),
+     * executors are expected to queue the record itself.
+     * @param task Task record (must stay alive until executed)
+     */
+    virtual void enqueue(WmTask* task)
+    {
+        enqueue(std::function<void()>([task]() { task->execute(); }));
+    }
+
+    /**
+     * @brief Enqueues batch of task records at once
+     * Default implementation enqueues them one by one,
+     * executors are expected to amortize synchronization over the batch.
+     * @param tasks Task records array
+     * @param count Number of records
+     */
+    virtual void enqueue_batch(WmTask* const* tasks, size_t count)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+            enqueue(tasks[idx]);
+    }
+
+    /**
+     * @brief Returns per-worker counters of the executor
+     * @return Executor metrics
+     */
+    virtual const WmExecutorMetrics& metrics() const noexcept = 0;
+
+    /**
+     * @brief Enqueues batch of task records tracked by completion handle
+     * Call completion.wait() to block until the whole batch is executed.
+     * @param tasks Task records array
+     * @param count Number of records
+     * @param completion Completion handle (must outlive the batch)
+     */
+    void submit(WmTask* const* tasks, size_t count, WmCompletion& completion)
+    {
+        completion.add(count);
+        for (size_t idx = 0; idx < count; ++idx)
+            tasks[idx]->completion = &completion;
+
+        enqueue_batch(tasks, count);
+    }
+
 protected:
     WmAbstractExecutor& operator = (const WmAbstractExecutor&) = delete;
     WmAbstractExecutor             (const WmAbstractExecutor&) = delete;
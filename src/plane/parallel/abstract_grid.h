@@ -40,6 +40,16 @@ public:
      */
     virtual WmGridGraph build_graph() const = 0;
 
+    /**
+     * @brief Builds graph of several consecutive executions of the grid
+     * Vertex window_idx * count + idx corresponds to access_node(idx) 
+     * executed in window window_idx, edges between windows are included,
+     * so no barrier is needed between them.
+     * @param window_cnt Number of windows
+     * @returns Corresponding graph
+     */
+    virtual WmGridGraph build_pipeline_graph(size_t window_cnt) const = 0;
+
 protected:
     WmAbstractGrid             (const WmAbstractGrid&) = delete;
     WmAbstractGrid& operator = (const WmAbstractGrid&) = delete;
@@ -0,0 +1,403 @@
+#ifndef WAVE_MODEL_PARALLEL_AFFINITY_H_
+#define WAVE_MODEL_PARALLEL_AFFINITY_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <tuple>
+#include <thread>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cctype>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif // __linux__
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Describes CPU topology of the host
+ * Is read from Linux sysfs, falls back to the flat topology
+ * of std::thread::hardware_concurrency() CPUs elsewhere.
+ */
+struct WmCpuTopology
+{
+    struct Test;
+
+    /// Single logical CPU description
+    struct Cpu
+    {
+        int cpu; ///< logical CPU index
+        int package; ///< physical package (socket) id
+        int core; ///< core id inside the package
+        int l2; ///< id of the L2 cache group (its first CPU)
+        int l3; ///< id of the L3 cache group (its first CPU)
+    };
+
+    /**
+     * @brief Parses CPU list in sysfs format (e.g. "0-3,8,10-11")
+     * @param list CPU list string
+     * @return CPU indices (empty if the list is malformed)
+     */
+    static std::vector<int> parse_cpu_list(const std::string& list)
+    {
+        std::vector<int> result;
+        std::stringstream stream(list);
+        std::string range;
+
+        while (std::getline(stream, range, ','))
+        {
+            if (range.empty() || range[0] == '\n')
+                continue;
+
+            size_t dash = range.find('-');
+            int first = 0;
+            int last = 0;
+
+            if (!parse_int(range.substr(0, dash), first) ||
+                !parse_int(dash == std::string::npos ?
+                           range : range.substr(dash + 1), last) ||
+                first < 0 || last < first)
+            {
+                return {};
+            }
+
+            for (int cpu = first; cpu <= last; ++cpu)
+                result.push_back(cpu);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Reads the topology of the CPUs available to the process
+     * @return Detected topology
+     */
+    static WmCpuTopology detect()
+    {
+        WmCpuTopology topology;
+
+        std::vector<int> cpus = parse_cpu_list(
+                read_line("/sys/devices/system/cpu/online"));
+
+#if defined(__linux__)
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+
+        if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+        {
+            cpus.erase(std::remove_if(std::begin(cpus), std::end(cpus),
+                        [&mask](int cpu)
+                        {
+                            return cpu >= CPU_SETSIZE ||
+                                   !CPU_ISSET(cpu, &mask);
+                        }),
+                       std::end(cpus));
+        }
+#endif // __linux__
+
+        if (cpus.empty())
+        {
+            int cpu_cnt = std::max(1u, std::thread::hardware_concurrency());
+            for (int cpu = 0; cpu < cpu_cnt; ++cpu)
+                topology.cpus.push_back({ cpu, 0, cpu, cpu, 0 });
+
+            return topology;
+        }
+
+        for (int cpu : cpus)
+        {
+            std::string path =
+                "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/";
+
+            Cpu info = { cpu,
+                read_int(path + "topology/physical_package_id", 0),
+                read_int(path + "topology/core_id", cpu),
+                cpu, cpu };
+
+            for (int cache_idx = 0; cache_idx < 8; ++cache_idx)
+            {
+                std::string cache_path =
+                    path + "cache/index" + std::to_string(cache_idx) + "/";
+
+                int level = read_int(cache_path + "level", -1);
+                if (level != 2 && level != 3)
+                    continue;
+
+                std::vector<int> shared = parse_cpu_list(
+                        read_line(cache_path + "shared_cpu_list"));
+
+                int group = (shared.empty() ? cpu : shared.front());
+                (level == 2 ? info.l2 : info.l3) = group;
+            }
+
+            topology.cpus.push_back(info);
+        }
+
+        return topology;
+    }
+
+    /**
+     * @brief Returns distance between CPUs in the cache hierarchy
+     * @return 0 - same core, 1 - shared L2, 2 - shared L3,
+     * 3 - same package, 4 - different packages
+     */
+    static int distance(const Cpu& lhs, const Cpu& rhs) noexcept
+    {
+        if (lhs.package != rhs.package) return 4;
+        if (lhs.core == rhs.core) return 0;
+        if (lhs.l2 == rhs.l2) return 1;
+        if (lhs.l3 == rhs.l3) return 2;
+
+        return 3;
+    }
+
+    std::vector<Cpu> cpus; ///< available logical CPUs
+
+private:
+    static std::string read_line(const std::string& path)
+    {
+        std::ifstream stream(path);
+        std::string line;
+        std::getline(stream, line);
+
+        return line;
+    }
+
+    /**
+     * @brief Parses decimal integer followed by whitespace only
+     * Doesn't throw unlike std::stoi: sysfs files may be masked
+     * or hold unexpected content in containers.
+     * @return Whether value is parsed
+     */
+    static bool parse_int(const std::string& text, int& value) noexcept
+    {
+        const char* begin = text.c_str();
+        char* end = nullptr;
+
+        errno = 0;
+        long parsed = std::strtol(begin, &end, 10);
+
+        if (end == begin || errno == ERANGE ||
+            parsed < INT_MIN || parsed > INT_MAX)
+        {
+            return false;
+        }
+
+        for (; *end != '\0'; ++end)
+        {
+            if (!std::isspace(static_cast<unsigned char>(*end)))
+                return false;
+        }
+
+        value = static_cast<int>(parsed);
+        return true;
+    }
+
+    static int read_int(const std::string& path, int fallback)
+    {
+        int value = fallback;
+
+        return parse_int(read_line(path), value) ? value : fallback;
+    }
+};
+
+/**
+ * @brief Describes how executor workers are pinned to CPUs
+ */
+struct WmAffinityPolicy
+{
+    enum EKind
+    {
+        AFFINITY_NONE, ///< no pinning, the OS decides
+        AFFINITY_COMPACT, ///< neighbouring workers share cores and caches
+        AFFINITY_SCATTER, ///< workers spread over packages and cores first
+        AFFINITY_EXPLICIT ///< workers pinned to cpu_list in order
+    };
+
+    /**
+     * @brief Assigns CPU to each worker
+     * @param workers_cnt Number of workers
+     * @param topology Host topology
+     * @return CPU of each worker (-1 means no pinning)
+     */
+    std::vector<int> assign(size_t workers_cnt,
+                            const WmCpuTopology& topology) const
+    {
+        std::vector<int> result(workers_cnt, -1);
+        std::vector<WmCpuTopology::Cpu> order = topology.cpus;
+
+        switch (kind)
+        {
+            case AFFINITY_NONE:
+                return result;
+
+            case AFFINITY_COMPACT:
+                std::stable_sort(std::begin(order), std::end(order),
+                    [](const auto& lhs, const auto& rhs) {
+                        return
+                            std::tie(lhs.package, lhs.l3, lhs.l2, lhs.core) <
+                            std::tie(rhs.package, rhs.l3, rhs.l2, rhs.core);
+                    });
+                break;
+
+            case AFFINITY_SCATTER:
+                order = scatter(order);
+                break;
+
+            case AFFINITY_EXPLICIT:
+                for (size_t idx = 0; idx < workers_cnt && !cpu_list.empty();
+                     ++idx)
+                    result[idx] = cpu_list[idx % cpu_list.size()];
+
+                return result;
+        }
+
+        for (size_t idx = 0; idx < workers_cnt && !order.empty(); ++idx)
+            result[idx] = order[idx % order.size()].cpu;
+
+        return result;
+    }
+
+    EKind kind = AFFINITY_NONE; ///< policy kind
+    std::vector<int> cpu_list = {}; ///< CPUs for AFFINITY_EXPLICIT
+
+private:
+    /**
+     * @brief Orders CPUs round-robin over packages, then over cores
+     * Hyperthread siblings come last.
+     */
+    static std::vector<WmCpuTopology::Cpu>
+    scatter(std::vector<WmCpuTopology::Cpu> cpus)
+    {
+        std::vector<int> rank(cpus.size(), 0);
+        std::vector<int> package_pos(cpus.size(), 0);
+
+        // rank = number of previous CPUs on the same core (SMT level)
+        // package_pos = number of previous cores in the same package
+        for (size_t idx = 0; idx < cpus.size(); ++idx)
+        {
+            for (size_t prev = 0; prev < idx; ++prev)
+            {
+                if (cpus[prev].package != cpus[idx].package)
+                    continue;
+
+                if (cpus[prev].core == cpus[idx].core)
+                    ++rank[idx];
+                else if (rank[prev] == 0)
+                    ++package_pos[idx];
+            }
+        }
+
+        std::vector<size_t> perm(cpus.size());
+        for (size_t idx = 0; idx < perm.size(); ++idx)
+            perm[idx] = idx;
+
+        std::stable_sort(std::begin(perm), std::end(perm),
+            [&](size_t lhs, size_t rhs) {
+                return std::tie(rank[lhs], package_pos[lhs],
+                                cpus[lhs].package) <
+                       std::tie(rank[rhs], package_pos[rhs],
+                                cpus[rhs].package);
+            });
+
+        std::vector<WmCpuTopology::Cpu> result;
+        for (size_t idx : perm)
+            result.push_back(cpus[idx]);
+
+        return result;
+    }
+};
+
+/**
+ * @brief Pins the calling thread to the CPU
+ * @param cpu CPU index (negative value means no pinning)
+ * @return true on success
+ */
+inline bool wm_pin_current_thread([[maybe_unused]] int cpu)
+{
+#if defined(__linux__)
+    if (cpu < 0)
+        return false;
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+
+#else // __linux__
+    return false;
+
+#endif // __linux__
+}
+
+/**
+ * @brief Test structure for WmCpuTopology
+ */
+struct WmCpuTopology::Test
+{
+    template<typename TStream>
+    static TStream& test_parse(TStream& stream)
+    {
+        std::vector<int> cpus = parse_cpu_list("0-2,5,7-8\n");
+
+        for (int cpu : cpus)
+            stream << cpu << ' ';
+
+        // malformed lists are rejected as a whole instead of throwing
+        const char* malformed[] = { "0-x", "3-1", "-2", "1,9999999999" };
+        for (const char* list : malformed)
+            stream << "| " << parse_cpu_list(list).size() << ' ';
+
+        return stream;
+    }
+
+    template<typename TStream>
+    static TStream& test_assign(TStream& stream)
+    {
+        // 2 packages x 2 cores x 2 threads
+        WmCpuTopology topology;
+        for (int cpu = 0; cpu < 8; ++cpu)
+        {
+            int package = cpu / 4;
+            int core = cpu % 2;
+            topology.cpus.push_back({ cpu, package, core,
+                                      package * 4 + core, package * 4 });
+        }
+
+        WmAffinityPolicy policies[] = {
+            { WmAffinityPolicy::AFFINITY_COMPACT, {} },
+            { WmAffinityPolicy::AFFINITY_SCATTER, {} },
+            { WmAffinityPolicy::AFFINITY_EXPLICIT, { 3, 1 } }
+        };
+
+        for (const auto& policy : policies)
+        {
+            for (int cpu : policy.assign(4, topology))
+                stream << cpu << ' ';
+
+            stream << '\n';
+        }
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_AFFINITY_H_
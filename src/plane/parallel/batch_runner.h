@@ -0,0 +1,290 @@
+#ifndef WAVE_MODEL_PARALLEL_BATCH_RUNNER_H_
+#define WAVE_MODEL_PARALLEL_BATCH_RUNNER_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "abstract_executor.h"
+#include "task.h"
+#include "completion.h"
+#include "sequential_executor.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Runs many independent jobs of the same domain on one executor
+ * Keeps slots_cnt solvers in flight, each processing its own job
+ * window by window: the next window of the job is started as soon as
+ * the previous one is done, so node graphs of all the slots are
+ * interleaved in the executor's queues and the workers stay busy
+ * even when a single domain is too small to scale.
+ * Jobs are admitted in their order and every admitted job has exactly
+ * one window in flight, so slots advance fairly.
+ * Solvers (with their layers, grids and schedules) are reused between jobs.
+ * @tparam TS Solver type (e.g. WmParallelSolver2D)
+ */
+template<typename TS>
+class WmBatchRunner
+{
+public:
+    struct Test;
+
+    using TSolver = TS;
+
+    /**
+     * @brief Ctor from executor and solvers parameters
+     * @tparam TArgs Solver's ctor arguments types
+     * @param executor Object to execute grid nodes of all the jobs
+     * @param slots_cnt Number of jobs in flight (one solver per slot)
+     * @param args Solver's ctor arguments
+     */
+    template<typename... TArgs>
+    WmBatchRunner(WmAbstractExecutor& executor, size_t slots_cnt,
+                  const TArgs&... args):
+        executor_{ executor },
+        slots_cnt_{ slots_cnt == 0 ? 1 : slots_cnt },
+        slots_{ std::make_unique<Slot[]>(slots_cnt_) }
+    {
+        for (size_t slot_idx = 0; slot_idx < slots_cnt_; ++slot_idx)
+        {
+            Slot& slot = slots_[slot_idx];
+
+            slot.solver = std::make_unique<TSolver>(args...);
+            slot.runner = this;
+            slot.completion.set_callback(&WmBatchRunner::notify, &slot);
+        }
+    }
+
+    WmBatchRunner             (const WmBatchRunner&) = delete;
+    WmBatchRunner& operator = (const WmBatchRunner&) = delete;
+
+    /**
+     * @brief Returns number of jobs in flight
+     */
+    size_t slots_count() const noexcept
+    {
+        return slots_cnt_;
+    }
+
+    /**
+     * @brief Runs jobs_cnt jobs of proc_cnt steps each
+     * Both functions are called by the calling thread (not the workers):
+     * init_func(job_idx, solver) resets the solver to the job's initial state
+     * (e.g. via solver.reset()), done_func(job_idx, solver) consumes
+     * the job's result before the solver is given to the next job.
+     * Blocks until all the jobs are done.
+     * @tparam TInitFunc Job initialization function type
+     * @tparam TDoneFunc Job result function type
+     * @param jobs_cnt Number of jobs
+     * @param proc_cnt Number of steps of each job
+     * @param init_func Job initialization function
+     * @param done_func Job result function
+     */
+    template<typename TInitFunc, typename TDoneFunc>
+    void run(size_t jobs_cnt, size_t proc_cnt,
+             TInitFunc&& init_func, TDoneFunc&& done_func)
+    {
+        static constexpr size_t NWindowSteps = (1u << TSolver::NTileRank);
+
+        size_t windows_cnt = (proc_cnt + NWindowSteps - 1) / NWindowSteps;
+
+        size_t next_job = 0;
+        size_t active_cnt = 0;
+
+        // gives the slot to the next job, returns false if there is none
+        auto admit = [&](Slot& slot) -> bool {
+                for (; next_job < jobs_cnt; ++next_job)
+                {
+                    slot.job_idx = next_job;
+                    slot.windows_left = windows_cnt;
+                    init_func(slot.job_idx, *slot.solver);
+
+                    if (windows_cnt > 0)
+                    {
+                        ++next_job;
+                        slot.solver->start_window(executor_, slot.completion);
+                        return true;
+                    }
+
+                    done_func(slot.job_idx, *slot.solver);
+                }
+
+                return false;
+            };
+
+        for (size_t slot_idx = 0; slot_idx < slots_cnt_; ++slot_idx)
+        {
+            if (admit(slots_[slot_idx]))
+                ++active_cnt;
+        }
+
+        std::vector<Slot*> finished;
+        while (active_cnt > 0)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_var_.wait(lock, [this]() -> bool {
+                        return !finished_.empty();
+                    });
+
+                finished.swap(finished_);
+            }
+
+            for (Slot* slot : finished)
+            {
+                // makes sure the last task has left the completion
+                slot->completion.wait();
+                slot->solver->finish_window();
+
+                if (--slot->windows_left > 0)
+                {
+                    slot->solver->start_window(executor_, slot->completion);
+                    continue;
+                }
+
+                done_func(slot->job_idx, *slot->solver);
+                if (!admit(*slot))
+                    --active_cnt;
+            }
+
+            finished.clear();
+        }
+    }
+
+private:
+    /// Solver processing one job at a time
+    struct Slot
+    {
+        std::unique_ptr<TSolver> solver{};
+        WmCompletion completion{};
+        WmBatchRunner* runner = nullptr;
+        size_t job_idx = 0;
+        size_t windows_left = 0;
+    };
+
+    /**
+     * @brief Reports the slot's window to be done (called by the workers)
+     */
+    static void notify(void* context)
+    {
+        auto* slot = static_cast<Slot*>(context);
+        WmBatchRunner* self = slot->runner;
+
+        std::unique_lock<std::mutex> lock(self->mutex_);
+        self->finished_.push_back(slot);
+        self->cond_var_.notify_one();
+    }
+
+    WmAbstractExecutor& executor_;
+    size_t slots_cnt_ = 0;
+    std::unique_ptr<Slot[]> slots_;
+
+    std::mutex mutex_{};
+    std::condition_variable cond_var_{};
+    std::vector<Slot*> finished_{};
+};
+
+/**
+ * @brief Test structure for WmBatchRunner
+ * Tests use their own solver, so TS may be any type (e.g. void).
+ */
+template<typename TS>
+struct WmBatchRunner<TS>::Test
+{
+    /// Solver adding one per window in the single task
+    struct TestSolver
+    {
+        static constexpr size_t NTileRank = 1;
+
+        explicit TestSolver(size_t* windows_ptr):
+            windows{ windows_ptr }
+        {}
+
+        void reset(size_t value_init)
+        {
+            value = value_init;
+        }
+
+        void start_window(WmAbstractExecutor& executor,
+                          WmCompletion& completion)
+        {
+            completion.add();
+
+            task.func = [](WmTask* task) {
+                    ++static_cast<TestTask*>(task)->solver->value;
+                };
+            task.solver = this;
+            task.completion = &completion;
+
+            executor.enqueue(&task);
+        }
+
+        void finish_window()
+        {
+            ++*windows;
+        }
+
+        struct TestTask : public WmTask
+        {
+            TestSolver* solver = nullptr;
+        };
+
+        size_t* windows = nullptr;
+        size_t value = 0;
+        TestTask task{};
+    };
+
+    template<typename TStream>
+    static TStream& test_init(TStream& stream)
+    {
+        size_t windows = 0;
+        WmSequentialExecutor executor;
+        WmBatchRunner<TestSolver> runner(executor, 0, &windows);
+
+        stream << runner.slots_count() << ' ';
+
+        return stream;
+    }
+
+    template<typename TExecutor, typename TStream>
+    static TStream& test_run(TStream& stream)
+    {
+        static constexpr size_t NJobsCount = 5;
+
+        size_t windows = 0;
+        std::vector<size_t> results(NJobsCount, 0);
+
+        TExecutor executor;
+        WmBatchRunner<TestSolver> runner(executor, 2, &windows);
+
+        // 5 steps are 3 windows of 2 steps
+        runner.run(NJobsCount, 5,
+                [](size_t job_idx, TestSolver& solver) {
+                    solver.reset(job_idx * 10);
+                },
+                [&results](size_t job_idx, const TestSolver& solver) {
+                    results[job_idx] = solver.value;
+                });
+
+        for (size_t result : results)
+            stream << result << ' ';
+        stream << windows << ' ';
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_BATCH_RUNNER_H_
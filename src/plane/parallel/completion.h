@@ -0,0 +1,118 @@
+#ifndef WAVE_MODEL_PARALLEL_COMPLETION_H_
+#define WAVE_MODEL_PARALLEL_COMPLETION_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Latch-like completion handle for the submitted tasks
+ * Counts unfinished tasks and lets the submitter wait for all of them.
+ * Can be reused for the next batch after wait() returns.
+ * Optional callback lets the submitter be notified without blocking
+ * on the particular handle (e.g. when waiting for any of many batches).
+ */
+class WmCompletion
+{
+public:
+    /**
+     * @brief Ctor from the initial count of unfinished tasks
+     * @param count Initial count
+     */
+    explicit WmCompletion(size_t count = 0):
+        count_{ count },
+        done_{ count == 0 }
+    {}
+
+    WmCompletion             (const WmCompletion&) = delete;
+    WmCompletion& operator = (const WmCompletion&) = delete;
+
+    /**
+     * @brief Registers more unfinished tasks
+     * Must be called before the registered tasks are executed.
+     * @param count Number of tasks
+     */
+    void add(size_t count = 1)
+    {
+        if (count == 0)
+            return;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        count_.fetch_add(count, std::memory_order_relaxed);
+        done_ = false;
+    }
+
+    /**
+     * @brief Sets function called each time all the tasks are finished
+     * Is called by the thread finishing the last task under the internal lock,
+     * so it must neither block nor touch the completion itself.
+     * @param callback Function receiving the context
+     * @param context Callback's argument
+     */
+    void set_callback(void (*callback)(void*), void* context) noexcept
+    {
+        callback_ = callback;
+        context_ = context;
+    }
+
+    /**
+     * @brief Marks tasks as finished
+     * @param count Number of tasks
+     */
+    void count_down(size_t count = 1)
+    {
+        if (count_.fetch_sub(count, std::memory_order_acq_rel) != count)
+            return;
+
+        // notified under the lock: the woken waiter may destroy the object
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_ = true;
+        cond_var_.notify_all();
+
+        if (callback_)
+            callback_(context_);
+    }
+
+    /**
+     * @brief Checks if all the tasks are finished without blocking
+     */
+    bool ready() const noexcept
+    {
+        return count_.load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * @brief Blocks until all the tasks are finished
+     * Must not be called from the worker of the executing executor.
+     */
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_var_.wait(lock, [this]() -> bool { return done_; });
+    }
+
+private:
+    std::atomic<size_t> count_{ 0 };
+    bool done_ = true;
+
+    void (*callback_)(void*) = nullptr;
+    void* context_ = nullptr;
+
+    std::mutex mutex_{};
+    std::condition_variable cond_var_{};
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_COMPLETION_H_
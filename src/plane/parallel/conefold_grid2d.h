@@ -57,71 +57,69 @@ public:
     using EType = typename TTiling::EType;
 
     static constexpr size_t NTime = TLayer::NDomainLengthX / NCellSide;
-    static constexpr size_t NNodes = NCellCountX * NCellCountY * NTime;
+    static constexpr size_t NCells = NCellCountX * NCellCountY;
+    static constexpr size_t NNodes = NCells * NTime;
 
     static_assert(NCellSide < TLayer::NDomainLengthX, 
                   "cell must be less than domain");
 
     /**
      * @brief Ctor from layers array and stencil
-     * Initializes internal nodes and additional data
+     * Initializes internal nodes and additional data.
+     * Nodes of the same cell differ only by their time level,
+     * so one node per cell is stored and shared by all the levels.
      */
     WmConeFoldGrid2D(TLayer* layers, TStencil& stencil):
         layers_{ layers },
         stencil_{ stencil },
         nodes_{}
     {
-        for (size_t cur_time = 0; cur_time < NTime; ++cur_time)
+        int64_t row_idx = 0;
+        for (int64_t y_idx = 0; y_idx < NCellCountY; ++y_idx)
         {
-            int64_t row_idx = 0;
-            for (int64_t y_idx = 0; y_idx < NCellCountY; ++y_idx)
+            int64_t idx = row_idx;
+            for (int64_t x_idx = 0; x_idx < NCellCountX; ++x_idx)
             {
-                int64_t idx = row_idx;
-                for (int64_t x_idx = 0; x_idx < NCellCountX; ++x_idx)
+                EType type_x = EType::TYPE_N;
+                switch (x_idx)
                 {
-                    EType type_x = EType::TYPE_N;
-                    switch (x_idx)
-                    {
-                        case 0: type_x = EType::TYPE_A; break;
-                        case 1: type_x = EType::TYPE_B; break;
-                        case NCellCountX - 1: 
-                                type_x = EType::TYPE_D; break;
-                        default: 
-                                type_x = EType::TYPE_C; break;
-                    }
-
-                    EType type_y = EType::TYPE_N;
-                    switch (y_idx)
-                    {
-                        case 0: type_y = EType::TYPE_A; break;
-                        case 1: type_y = EType::TYPE_B; break;
-                        case NCellCountY - 1: 
-                                type_y = EType::TYPE_D; break;
-                        default: 
-                                type_y = EType::TYPE_C; break;
-                    }
-
-                    int64_t node_idx = NCellCountX * NCellCountY * cur_time + 
-                                       y_idx * NCellCountX + x_idx;
-
-                    nodes_[node_idx] = TNode(idx, type_x, type_y, 
-                                             &stencil_, layers_);
-
-                    idx += TLayer::template off_right<NCellRank>(idx, 1u);
+                    case 0: type_x = EType::TYPE_A; break;
+                    case 1: type_x = EType::TYPE_B; break;
+                    case NCellCountX - 1: 
+                            type_x = EType::TYPE_D; break;
+                    default: 
+                            type_x = EType::TYPE_C; break;
                 }
 
-                row_idx += TLayer::template off_bottom<NCellRank>(row_idx, 1u);
+                EType type_y = EType::TYPE_N;
+                switch (y_idx)
+                {
+                    case 0: type_y = EType::TYPE_A; break;
+                    case 1: type_y = EType::TYPE_B; break;
+                    case NCellCountY - 1: 
+                            type_y = EType::TYPE_D; break;
+                    default: 
+                            type_y = EType::TYPE_C; break;
+                }
+
+                nodes_[y_idx * NCellCountX + x_idx] = 
+                    TNode(idx, type_x, type_y, &stencil_, layers_);
+
+                idx += TLayer::template off_right<NCellRank>(idx, 1u);
             }
+
+            row_idx += TLayer::template off_bottom<NCellRank>(row_idx, 1u);
         }
     }
 
     /**
      * @brief Returns pointer to idx'th node
+     * Node is derived from the cell of the vertex idx.
      * @see WmAbstractGrid::access_node()
      */
     TNode* access_node(size_t idx) override final
     {
-        return nodes_ + idx;
+        return nodes_ + idx % NCells;
     }
 
     /**
@@ -129,16 +127,47 @@ public:
      * @see WmAbstractGrid::build_graph()
      */
     WmGridGraph build_graph() const override final
+    {
+        return build_pipeline_graph(1);
+    }
+
+    /**
+     * @brief Models node costs as numbers of their stencil applications
+     * Costs are listed in the same order as the nodes of build_graph().
+     * @return Modeled costs of the nodes
+     */
+    std::vector<double> model_costs() const
+    {
+        std::vector<double> costs(NNodes, 0.0);
+        for (size_t idx = 0; idx < NNodes; ++idx)
+        {
+            costs[idx] =
+                static_cast<double>(nodes_[idx % NCells].count_cells());
+        }
+
+        return costs;
+    }
+
+    /**
+     * @brief Builds conefold structure graph of several windows
+     * The next window continues the time levels of the previous one.
+     * @see WmAbstractGrid::build_pipeline_graph()
+     */
+    WmGridGraph build_pipeline_graph(size_t window_cnt) const override final
     {
         static constexpr int64_t NDiagCnt = NCellCountX + NCellCountY - 1;
 
+        const size_t time_cnt = NTime * window_cnt;
+
         WmGridGraph graph = {};
-        graph.count = NTime * NCellCountY * NCellCountX;
+        graph.count = time_cnt * NCellCountY * NCellCountX;
         graph.order.reserve(graph.count);
-        graph.graph.resize(graph.count);
+        graph.offsets.reserve(graph.count + 1);
+        graph.edges.reserve(3 * graph.count);
 
-        for (size_t cur_time = 0; cur_time < NTime; ++cur_time)
+        for (size_t cur_time = 0; cur_time < time_cnt; ++cur_time)
         {
+            // nodes are visited in index order, so offsets are appended
             for (int64_t idx = 0; idx < NCellCountY * NCellCountX; ++idx)
             {
                 int64_t node_idx = 
@@ -152,22 +181,18 @@ public:
                 int64_t add_time = NCellCountY * NCellCountX;
 
                 if (x_idx < NCellCountX - 1)
-                {
-                    graph.graph[node_idx]
-                        .push_back(node_idx + 1);
-                }
+                    graph.edges.push_back(node_idx + 1);
 
                 if (y_idx < NCellCountY - 1)
-                {
-                    graph.graph[node_idx]
-                        .push_back(node_idx + add_y);
-                }
+                    graph.edges.push_back(node_idx + add_y);
 
                 if (x_idx > 0 && y_idx > 0 && cur_time > 0)
                 {
-                    graph.graph[node_idx]
+                    graph.edges
                         .push_back(node_idx - add_time - add_x - add_y);
                 }
+
+                graph.offsets.push_back(graph.edges.size());
             }
 
             for (int64_t diag = NDiagCnt - 1; diag >= 0; --diag)
@@ -180,7 +205,7 @@ public:
                 {
                     graph.order.push_back(
                             cur_time * NCellCountY * NCellCountX + 
-                            y_idx * NCellCountY + x_idx);
+                            y_idx * NCellCountX + x_idx);
                 }
             }
         }
@@ -191,7 +216,7 @@ public:
 private:
     TLayer* layers_;
     TStencil& stencil_;
-    TNode nodes_[NNodes];
+    TNode nodes_[NCells];
 };
 
 } // namespace wave_model
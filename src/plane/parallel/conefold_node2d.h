@@ -32,6 +32,9 @@ public:
     using TTiling = WmGeneralConeFoldTiling2D<NRank>;
     using EType = typename TTiling::EType;
 
+    /// Number of children (2x2 folds of the lower and upper time halves)
+    static constexpr size_t NParts = 8;
+
     /**
      * @brief Default ctor
      * Produces invalid node.
@@ -58,12 +61,144 @@ public:
      */
     void execute() override final
     {
-        proc_fold();
+        proc_fold(*stencil_);
+    }
+
+    /**
+     * @brief Executes node calculations starting from the given layer
+     * Allows to emulate layers rotation per node instead of the global one.
+     * @param layer_idx Index of the first layer to calculate 
+     * (must be less than TStencil::NMod)
+     */
+    void execute(size_t layer_idx)
+    {
+        call_fold<TStencil::NMod - 1>(layer_idx);
+    }
+
+    /**
+     * @brief Executes the child fold of the node
+     * Children are the folds of the lower rank listed in the order
+     * they are processed by the tiling: XY, 0Y, X0, 00 of the lower
+     * half, then the same of the upper one. 0Y and X0 of the same half
+     * are independent, the rest must be executed in order.
+     * Child types are derived via TTiling::TypeMtx.
+     * @param part_idx Child's index (must be less than NParts)
+     * @param layer_idx Index of the node's first layer
+     */
+    void execute_part(size_t part_idx, size_t layer_idx)
+    {
+        if constexpr (NRank > 0)
+        {
+            static constexpr size_t NLess = NRank - 1;
+            static constexpr size_t NDepth = TStencil::NDepth;
+
+            // columns of TTiling::TypeMtx by X and by Y
+            static constexpr size_t NColsX[NParts] = { 1, 0, 1, 0, 3, 2, 3, 2 };
+            static constexpr size_t NColsY[NParts] = { 1, 1, 0, 0, 3, 3, 2, 2 };
+
+            using TChild = WmConeFoldNode2D<TLayer, TStencil, NLess>;
+            using EChildType = typename TChild::EType;
+
+            int64_t x_off = 0;
+            int64_t y_off = 0;
+
+            switch (part_idx)
+            {
+                case 1: case 3:
+                    x_off = TLayer::template off_left<NLess>(idx_, 1); break;
+                case 4: case 6:
+                    x_off = TLayer::template off_right<NLess>(idx_, 1); break;
+                default: break;
+            }
+
+            switch (part_idx)
+            {
+                case 2: case 3:
+                    y_off = TLayer::template off_top<NLess>(idx_, 1); break;
+                case 4: case 5:
+                    y_off = TLayer::template off_bottom<NLess>(idx_, 1); break;
+                default: break;
+            }
+
+            if (part_idx >= NParts / 2)
+                layer_idx = (layer_idx + (1u << NLess)) % NDepth;
+
+            TChild child(
+                static_cast<size_t>(static_cast<int64_t>(idx_) + x_off + y_off),
+                static_cast<EChildType>(
+                    TTiling::TypeMtx[type_x_][NColsX[part_idx]]),
+                static_cast<EChildType>(
+                    TTiling::TypeMtx[type_y_][NColsY[part_idx]]),
+                stencil_, layers_);
+
+            child.execute(layer_idx);
+        }
+    }
+
+    /**
+     * @brief Returns cell type by X
+     */
+    EType type_x() const noexcept
+    {
+        return type_x_;
+    }
+
+    /**
+     * @brief Returns cell type by Y
+     */
+    EType type_y() const noexcept
+    {
+        return type_y_;
+    }
+
+    /**
+     * @brief Counts stencil applications made by the node
+     * Boundary nodes process only the part of their fold,
+     * so the count is the modeled cost of the node.
+     * Layers are not accessed.
+     * @return Number of stencil applications
+     */
+    size_t count_cells() const
+    {
+        CountingStencil stencil;
+        proc_fold(stencil);
+
+        return stencil.count;
     }
 
 protected:
-    template<EType NTypeX = EType::TYPE_N, EType NTypeY = EType::TYPE_N>
-    void proc_fold()
+    /// Stencil counting its applications instead of calculating
+    struct CountingStencil
+    {
+        static constexpr size_t NDepth = TStencil::NDepth;
+        static constexpr size_t NMod = TStencil::NMod;
+
+        mutable size_t count = 0;
+
+        template<int NXSide, int NYSide, size_t NLayerIdx,
+                 typename TGeneralLayer>
+        void apply(int64_t, TGeneralLayer*) const noexcept
+        {
+            ++count;
+        }
+    };
+
+    template<size_t NLayerIdx>
+    void call_fold(size_t layer_idx)
+    {
+        if (layer_idx == NLayerIdx)
+        {
+            proc_fold<EType::TYPE_N, EType::TYPE_N, NLayerIdx>(*stencil_);
+        }
+        else if constexpr (NLayerIdx != 0)
+        {
+            call_fold<NLayerIdx - 1>(layer_idx);
+        }
+    }
+
+    template<EType NTypeX = EType::TYPE_N, EType NTypeY = EType::TYPE_N, 
+             size_t NLayerIdx = 0, typename TFoldStencil = TStencil>
+    void proc_fold(const TFoldStencil& stencil) const
     {
         static constexpr EType NTypeN = EType::TYPE_N;
 
@@ -71,10 +206,14 @@ protected:
         {
             switch (type_x_) 
             {
-                case EType::TYPE_A: proc_fold<EType::TYPE_A, NTypeN>(); break;
-                case EType::TYPE_B: proc_fold<EType::TYPE_B, NTypeN>(); break;
-                case EType::TYPE_C: proc_fold<EType::TYPE_C, NTypeN>(); break;
-                case EType::TYPE_D: proc_fold<EType::TYPE_D, NTypeN>(); break;
+                case EType::TYPE_A: 
+                    proc_fold<EType::TYPE_A, NTypeN, NLayerIdx>(stencil); break;
+                case EType::TYPE_B: 
+                    proc_fold<EType::TYPE_B, NTypeN, NLayerIdx>(stencil); break;
+                case EType::TYPE_C: 
+                    proc_fold<EType::TYPE_C, NTypeN, NLayerIdx>(stencil); break;
+                case EType::TYPE_D: 
+                    proc_fold<EType::TYPE_D, NTypeN, NLayerIdx>(stencil); break;
                 case EType::TYPE_N: /* TODO: ERROR! */ break;
                 // default: /* TODO: ERROR! */ break;
             }
@@ -83,18 +222,22 @@ protected:
         {
             switch (type_y_) 
             {
-                case EType::TYPE_A: proc_fold<NTypeX, EType::TYPE_A>(); break;
-                case EType::TYPE_B: proc_fold<NTypeX, EType::TYPE_B>(); break;
-                case EType::TYPE_C: proc_fold<NTypeX, EType::TYPE_C>(); break;
-                case EType::TYPE_D: proc_fold<NTypeX, EType::TYPE_D>(); break;
+                case EType::TYPE_A: 
+                    proc_fold<NTypeX, EType::TYPE_A, NLayerIdx>(stencil); break;
+                case EType::TYPE_B: 
+                    proc_fold<NTypeX, EType::TYPE_B, NLayerIdx>(stencil); break;
+                case EType::TYPE_C: 
+                    proc_fold<NTypeX, EType::TYPE_C, NLayerIdx>(stencil); break;
+                case EType::TYPE_D: 
+                    proc_fold<NTypeX, EType::TYPE_D, NLayerIdx>(stencil); break;
                 case EType::TYPE_N: /* TODO: ERROR! */ break;
                 // default: /* TODO: ERROR! */ break;
             }
         }
         else
         {
-            TTiling::template proc_fold<NRank, NTypeX, NTypeY, 0>
-                (idx_, *stencil_, layers_);
+            TTiling::template proc_fold<NRank, NTypeX, NTypeY, NLayerIdx>
+                (idx_, stencil, layers_);
         }
     }
 
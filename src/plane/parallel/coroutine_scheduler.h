@@ -0,0 +1,301 @@
+#ifndef WAVE_MODEL_PARALLEL_COROUTINE_SCHEDULER_H_
+#define WAVE_MODEL_PARALLEL_COROUTINE_SCHEDULER_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    #define WM_HAS_COROUTINES
+
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#if defined(WM_HAS_COROUTINES)
+
+#include "abstract_executor.h"
+#include "task.h"
+#include "completion.h"
+#include "grid_graph.h"
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <coroutine>
+#include <exception>
+
+#include <cstdint>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Schedules grid nodes as coroutines awaiting their predecessors
+ * Each node is the persistent coroutine suspended until all of its
+ * predecessors are done in the current run, so any number of nodes
+ * is in flight without occupying threads. Node is resumed by the worker
+ * completing its last predecessor: the first ready successor is resumed
+ * right away by symmetric transfer (and uses the data just produced
+ * while it's in cache), the rest are enqueued to the executor.
+ * Coroutine frames and task records are allocated once in the ctor.
+ * Is available only when compiled as C++20 (see WM_HAS_COROUTINES).
+ */
+class WmCoroutineScheduler
+{
+public:
+    struct Test;
+
+    /**
+     * @brief Ctor from the grid graph
+     * @param graph Grid graph (graph[idx] lists the nodes idx depends on)
+     */
+    explicit WmCoroutineScheduler(const WmGridGraph& graph):
+        count_{ graph.count },
+        in_degrees_(graph.count, 0),
+        successors_{ wm_successors_graph(graph) },
+        root_tasks_{},
+        counters_{ std::make_unique<std::atomic<uint32_t>[]>(graph.count) },
+        tasks_{ std::make_unique<ResumeTask[]>(graph.count) }
+    {
+        for (size_t idx = 0; idx < count_; ++idx)
+        {
+            in_degrees_[idx] =
+                static_cast<uint32_t>(graph.dependencies(idx).size());
+        }
+
+        std::vector<size_t> priorities = wm_critical_path_lengths(graph);
+        for (size_t idx = 0; idx < count_; ++idx)
+        {
+            tasks_[idx].func = &WmCoroutineScheduler::resume_node;
+            tasks_[idx].priority = priorities[idx];
+            tasks_[idx].handle = node_coroutine(idx).handle;
+        }
+
+        for (size_t idx : graph.order)
+        {
+            if (in_degrees_[idx] == 0)
+                root_tasks_.push_back(&tasks_[idx]);
+        }
+    }
+
+    WmCoroutineScheduler             (const WmCoroutineScheduler&) = delete;
+    WmCoroutineScheduler& operator = (const WmCoroutineScheduler&) = delete;
+
+    /**
+     * @brief Dtor
+     * Destroys the suspended node coroutines
+     */
+    ~WmCoroutineScheduler()
+    {
+        for (size_t idx = 0; idx < count_; ++idx)
+            tasks_[idx].handle.destroy();
+    }
+
+    /**
+     * @brief Sets preferred workers of the nodes
+     * @see WmDataflowScheduler::set_homes()
+     */
+    void set_homes(const std::vector<size_t>& homes)
+    {
+        for (size_t idx = 0; idx < count_ && !homes.empty(); ++idx)
+            tasks_[idx].home = homes[idx % homes.size()];
+    }
+
+    /**
+     * @brief Executes func(idx) for each node respecting dependencies
+     * Blocks the calling thread (not the workers) until all nodes are done.
+     * @tparam TFunc Node function type
+     * @param executor Object to resume nodes
+     * @param func Node function
+     */
+    template<typename TFunc>
+    void run(WmAbstractExecutor& executor, TFunc&& func)
+    {
+        start(executor, func, completion_);
+        completion_.wait();
+    }
+
+    /**
+     * @brief Starts executing func(idx) for each node without blocking
+     * Previous run must be finished before the next one is started.
+     * @tparam TFunc Node function type
+     * @param executor Object to resume nodes
+     * @param func Node function (must outlive the run)
+     * @param completion Handle to wait for all the nodes to be done
+     */
+    template<typename TFunc>
+    void start(WmAbstractExecutor& executor, TFunc& func,
+               WmCompletion& completion)
+    {
+        for (size_t idx = 0; idx < count_; ++idx)
+            counters_[idx].store(in_degrees_[idx], std::memory_order_relaxed);
+
+        executor_ = &executor;
+        completion_ptr_ = &completion;
+        context_ = static_cast<void*>(&func);
+        body_ = [](void* context, size_t idx) {
+                (*static_cast<TFunc*>(context))(idx);
+            };
+
+        completion.add(count_);
+        executor.enqueue_batch(root_tasks_.data(), root_tasks_.size());
+    }
+
+private:
+    /// Coroutine of the node (never finishes by itself)
+    struct NodeCoroutine
+    {
+        struct promise_type
+        {
+            NodeCoroutine get_return_object() noexcept
+            {
+                return { std::coroutine_handle<promise_type>
+                    ::from_promise(*this) };
+            }
+
+            // the first resumption is made when the node is ready
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    /// Preallocated record resuming the node
+    struct ResumeTask : public WmTask
+    {
+        std::coroutine_handle<> handle{};
+    };
+
+    /**
+     * @brief Awaiter releasing the node's successors
+     * Suspends the node until its predecessors are done in the next run
+     * and transfers the thread to the first successor made ready.
+     */
+    struct ReleaseAwaiter
+    {
+        WmCoroutineScheduler* self;
+        size_t idx;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<>) const
+        {
+            // the run may be finished (and the next one started) by count_down
+            WmCompletion* completion = self->completion_ptr_;
+            ResumeTask* next = nullptr;
+
+            for (size_t successor : self->successors_.dependencies(idx))
+            {
+                if (self->counters_[successor]
+                        .fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+
+                if (next)
+                    self->executor_->enqueue(&self->tasks_[successor]);
+                else
+                    next = &self->tasks_[successor];
+            }
+
+            completion->count_down();
+
+            return next ? next->handle : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Body of the node's coroutine
+     */
+    NodeCoroutine node_coroutine(size_t idx)
+    {
+        while (true)
+        {
+            body_(context_, idx);
+            co_await ReleaseAwaiter{ this, idx };
+        }
+    }
+
+    /**
+     * @brief Resumes the node enqueued to the executor
+     */
+    static void resume_node(WmTask* task)
+    {
+        static_cast<ResumeTask*>(task)->handle.resume();
+    }
+
+    size_t count_ = 0;
+    std::vector<uint32_t> in_degrees_;
+    WmGridGraph successors_;
+    std::vector<WmTask*> root_tasks_;
+
+    std::unique_ptr<std::atomic<uint32_t>[]> counters_;
+    std::unique_ptr<ResumeTask[]> tasks_;
+    WmCompletion completion_{};
+
+    WmAbstractExecutor* executor_ = nullptr;
+    WmCompletion* completion_ptr_ = nullptr;
+    void* context_ = nullptr;
+    void (*body_)(void*, size_t) = nullptr;
+};
+
+/**
+ * @brief Test structure for WmCoroutineScheduler
+ */
+struct WmCoroutineScheduler::Test
+{
+    template<typename TStream>
+    static TStream& test_init(TStream& stream)
+    {
+        WmGridGraph graph = { 0, {}, {} };
+        WmCoroutineScheduler scheduler(graph);
+
+        return stream;
+    }
+
+    template<typename TExecutor, typename TStream>
+    static TStream& test_run(TStream& stream)
+    {
+        // 0 <- 1 <- 3
+        //  ^-- 2 <-/
+        WmGridGraph graph = {
+            4, { 0, 1, 2, 3 }, { {}, { 0 }, { 0 }, { 1, 2 } }
+        };
+        WmCoroutineScheduler scheduler(graph);
+
+        std::atomic<size_t> done[4] = {};
+        std::atomic<size_t> order_errors{ 0 };
+
+        TExecutor executor;
+        for (size_t run_idx = 0; run_idx < 2; ++run_idx)
+        {
+            scheduler.run(executor, [&](size_t idx) {
+                    for (size_t dependency : graph.dependencies(idx))
+                    {
+                        if (done[dependency].load() != run_idx + 1)
+                            order_errors.fetch_add(1);
+                    }
+
+                    done[idx].fetch_add(1);
+                });
+        }
+
+        stream << order_errors.load();
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // defined(WM_HAS_COROUTINES)
+
+#endif // WAVE_MODEL_PARALLEL_COROUTINE_SCHEDULER_H_
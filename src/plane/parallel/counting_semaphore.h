@@ -7,6 +7,8 @@
  * @version 2.0
  */
 
+#include "executor_metrics.h"
+
 #if defined(__cpp_lib_semaphore)
     #include <semaphore>
 #else // __cpp_lib_semaphore
@@ -35,6 +37,7 @@ public:
 
     void acquire()
     {
+        WmBlockedScope blocked;
         semaphore_.acquire();
     }
 
@@ -59,6 +62,8 @@ public:
 
     void acquire()
     {
+        WmBlockedScope blocked;
+
         std::unique_lock<std::mutex> lock(mutex_);
         cond_var_.wait(lock, [this]() -> bool { return value_ > 0; });
         --value_;
@@ -66,9 +71,9 @@ public:
 
     void release(ptrdiff_t update = 1)
     {
+        // notified under the lock: the woken waiter may destroy the object
         std::unique_lock<std::mutex> lock(mutex_);
         value_ += update;
-        lock.unlock();
 
         while (update-- > 0)
             cond_var_.notify_one();
@@ -0,0 +1,304 @@
+#ifndef WAVE_MODEL_PARALLEL_DATAFLOW_SCHEDULER_H_
+#define WAVE_MODEL_PARALLEL_DATAFLOW_SCHEDULER_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "abstract_executor.h"
+#include "task.h"
+#include "completion.h"
+#include "grid_graph.h"
+
+#include <vector>
+#include <memory>
+#include <atomic>
+
+#include <cstdint>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Schedules grid nodes in dataflow manner
+ * Turns grid graph into the successor lists and in-degree counters.
+ * Node is enqueued to the executor only when the last of its predecessors
+ * is finished, so no task ever blocks waiting for its neighbours.
+ * Task records are preallocated per node, so the run itself does
+ * no allocations. Node's priority is its longest remaining path,
+ * so the executors honoring priorities run critical path first.
+ * Node function may defer the node's completion (e.g. to finish it
+ * by its own child tasks) and detect starvation of the workers.
+ */
+class WmDataflowScheduler
+{
+public:
+    struct Test;
+
+    /**
+     * @brief Ctor from the grid graph
+     * @param graph Grid graph (graph[idx] lists the nodes idx depends on)
+     */
+    explicit WmDataflowScheduler(const WmGridGraph& graph):
+        count_{ graph.count },
+        in_degrees_(graph.count, 0),
+        successors_{ wm_successors_graph(graph) },
+        root_tasks_{},
+        counters_{ std::make_unique<std::atomic<uint32_t>[]>(graph.count) },
+        tasks_{ std::make_unique<NodeTask[]>(graph.count) }
+    {
+        for (size_t idx = 0; idx < count_; ++idx)
+        {
+            in_degrees_[idx] =
+                static_cast<uint32_t>(graph.dependencies(idx).size());
+        }
+
+        std::vector<size_t> priorities = wm_critical_path_lengths(graph);
+        for (size_t idx = 0; idx < count_; ++idx)
+        {
+            tasks_[idx].func = &WmDataflowScheduler::execute_node;
+            tasks_[idx].priority = priorities[idx];
+            tasks_[idx].scheduler = this;
+            tasks_[idx].idx = idx;
+        }
+
+        for (size_t idx : graph.order)
+        {
+            if (in_degrees_[idx] == 0)
+                root_tasks_.push_back(&tasks_[idx]);
+        }
+    }
+
+    WmDataflowScheduler             (const WmDataflowScheduler&) = delete;
+    WmDataflowScheduler& operator = (const WmDataflowScheduler&) = delete;
+
+    /**
+     * @brief Sets preferred workers of the nodes
+     * Homes are repeated periodically if there are fewer of them
+     * than nodes (e.g. homes of the single window for pipeline graph).
+     * @param homes Worker's index per node (WmTask::NNoHome for any)
+     */
+    void set_homes(const std::vector<size_t>& homes)
+    {
+        for (size_t idx = 0; idx < count_ && !homes.empty(); ++idx)
+            tasks_[idx].home = homes[idx % homes.size()];
+    }
+
+    /**
+     * @brief Executes func(idx) for each node respecting dependencies
+     * Blocks the calling thread (not the workers) until all nodes are done.
+     * @tparam TFunc Node function type
+     * @param executor Object to execute nodes
+     * @param func Node function
+     */
+    template<typename TFunc>
+    void run(WmAbstractExecutor& executor, TFunc&& func)
+    {
+        start(executor, func, completion_);
+        completion_.wait();
+    }
+
+    /**
+     * @brief Starts executing func(idx) for each node without blocking
+     * Previous run must be finished before the next one is started.
+     * @tparam TFunc Node function type
+     * @param executor Object to execute nodes
+     * @param func Node function (must outlive the run)
+     * @param completion Handle to wait for all the nodes to be done
+     */
+    template<typename TFunc>
+    void start(WmAbstractExecutor& executor, TFunc& func, 
+               WmCompletion& completion)
+    {
+        for (size_t idx = 0; idx < count_; ++idx)
+        {
+            counters_[idx].store(in_degrees_[idx], std::memory_order_relaxed);
+            tasks_[idx].completion = &completion;
+        }
+
+        executor_ = &executor;
+        workers_cnt_ = executor.metrics().workers_count();
+        active_.store(root_tasks_.size(), std::memory_order_relaxed);
+
+        context_ = static_cast<void*>(&func);
+        body_ = [](void* context, size_t idx) {
+                (*static_cast<TFunc*>(context))(idx);
+            };
+
+        // successors are counted too: they are registered before the roots
+        completion.add(count_);
+        executor.enqueue_batch(root_tasks_.data(), root_tasks_.size());
+    }
+
+    /**
+     * @brief Checks if there are fewer ready nodes than workers
+     * Counts the nodes enqueued or being executed in the current run,
+     * tasks spawned by the nodes themselves are not counted.
+     * Is meant to be called by the node function.
+     */
+    bool starving() const noexcept
+    {
+        return active_.load(std::memory_order_relaxed) < workers_cnt_;
+    }
+
+    /**
+     * @brief Defers completion of the node until complete() is called
+     * Must be called by the node's function before the tasks
+     * finishing the node are started.
+     * @param idx Index of the node being executed
+     */
+    void defer(size_t idx)
+    {
+        deferred() = true;
+        tasks_[idx].completion->add();
+    }
+
+    /**
+     * @brief Completes the deferred node
+     * Enqueues its ready successors, may finish the whole run.
+     * @param idx Index of the deferred node
+     */
+    void complete(size_t idx)
+    {
+        WmCompletion* completion = tasks_[idx].completion;
+
+        release(idx);
+        completion->count_down();
+    }
+
+    /**
+     * @brief Enqueues the task to the executor of the current run
+     * Allows the node function to spawn its child tasks.
+     * @param task Task record to be enqueued
+     */
+    void spawn(WmTask* task)
+    {
+        executor_->enqueue(task);
+    }
+
+private:
+    /// Preallocated task record of the node
+    struct NodeTask : public WmTask
+    {
+        WmDataflowScheduler* scheduler = nullptr;
+        size_t idx = 0;
+    };
+
+    /**
+     * @brief Returns whether the node executed by the thread is deferred
+     * Is thread-local: the record may be reused by the next run
+     * as soon as the deferred node is completed by another thread.
+     */
+    static bool& deferred() noexcept
+    {
+        static thread_local bool is_deferred = false;
+        return is_deferred;
+    }
+
+    /**
+     * @brief Executes the node and enqueues its ready successors
+     */
+    static void execute_node(WmTask* task)
+    {
+        auto* node_task = static_cast<NodeTask*>(task);
+        WmDataflowScheduler* self = node_task->scheduler;
+        size_t idx = node_task->idx;
+
+        self->body_(self->context_, idx);
+
+        if (deferred())
+        {
+            deferred() = false;
+            return;
+        }
+
+        self->release(idx);
+    }
+
+    /**
+     * @brief Enqueues ready successors of the finished node
+     */
+    void release(size_t idx)
+    {
+        for (size_t successor : successors_.dependencies(idx))
+        {
+            if (counters_[successor]
+                    .fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                active_.fetch_add(1, std::memory_order_relaxed);
+                executor_->enqueue(&tasks_[successor]);
+            }
+        }
+
+        active_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    size_t count_ = 0;
+    std::vector<uint32_t> in_degrees_;
+    WmGridGraph successors_;
+    std::vector<WmTask*> root_tasks_;
+
+    std::unique_ptr<std::atomic<uint32_t>[]> counters_;
+    std::unique_ptr<NodeTask[]> tasks_;
+    WmCompletion completion_{};
+
+    WmAbstractExecutor* executor_ = nullptr;
+    size_t workers_cnt_ = 0;
+    std::atomic<size_t> active_{ 0 };
+
+    void* context_ = nullptr;
+    void (*body_)(void*, size_t) = nullptr;
+};
+
+/**
+ * @brief Test structure for WmDataflowScheduler
+ */
+struct WmDataflowScheduler::Test
+{
+    template<typename TStream>
+    static TStream& test_init(TStream& stream)
+    {
+        WmGridGraph graph = { 0, {}, {} };
+        WmDataflowScheduler scheduler(graph);
+
+        return stream;
+    }
+
+    template<typename TExecutor, typename TStream>
+    static TStream& test_run(TStream& stream)
+    {
+        // 0 <- 1 <- 3
+        //  ^-- 2 <-/
+        WmGridGraph graph = {
+            4, { 0, 1, 2, 3 }, { {}, { 0 }, { 0 }, { 1, 2 } }
+        };
+        WmDataflowScheduler scheduler(graph);
+
+        std::atomic<size_t> done[4] = {};
+        std::atomic<size_t> order_errors{ 0 };
+
+        TExecutor executor;
+        for (size_t run_idx = 0; run_idx < 2; ++run_idx)
+        {
+            scheduler.run(executor, [&](size_t idx) {
+                    for (size_t dependency : graph.dependencies(idx))
+                    {
+                        if (done[dependency].load() != run_idx + 1)
+                            order_errors.fetch_add(1);
+                    }
+
+                    done[idx].fetch_add(1);
+                });
+        }
+
+        stream << order_errors.load();
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_DATAFLOW_SCHEDULER_H_
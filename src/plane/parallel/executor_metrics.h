@@ -0,0 +1,275 @@
+#ifndef WAVE_MODEL_PARALLEL_EXECUTOR_METRICS_H_
+#define WAVE_MODEL_PARALLEL_EXECUTOR_METRICS_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+#include <cstdint>
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Per-worker counters of the executor
+ * Are always on: each worker updates only its own cache-line-aligned
+ * counters with relaxed atomics, so a snapshot can be taken at any time.
+ * Busy time includes the time blocked inside the tasks
+ * (see WmBlockedScope), idle time is the time spent searching
+ * for the tasks or sleeping without them.
+ */
+class WmExecutorMetrics
+{
+public:
+    struct Test;
+
+    /// Cache-line-aligned counters of the single worker
+    struct alignas(64) Counters
+    {
+        std::atomic<int64_t> busy_ns{ 0 };
+        std::atomic<int64_t> idle_ns{ 0 };
+        std::atomic<int64_t> blocked_ns{ 0 };
+        std::atomic<size_t> tasks{ 0 };
+        std::atomic<size_t> max_queue_depth{ 0 };
+
+        /**
+         * @brief Adds the task executed during [start, end)
+         */
+        void add_task(int64_t start, int64_t end) noexcept
+        {
+            add(busy_ns, end - start);
+            tasks.store(tasks.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Adds the idle interval [start, end)
+         */
+        void add_idle(int64_t start, int64_t end) noexcept
+        {
+            add(idle_ns, end - start);
+        }
+
+        /**
+         * @brief Records the worker's queue depth (may be called by others)
+         */
+        void observe_depth(size_t depth) noexcept
+        {
+            size_t max_depth = max_queue_depth.load(std::memory_order_relaxed);
+            while (max_depth < depth &&
+                   !max_queue_depth.compare_exchange_weak(max_depth, depth,
+                        std::memory_order_relaxed))
+                ;
+        }
+
+        /**
+         * @brief Adds value to the counter owned by the calling thread
+         */
+        static void add(std::atomic<int64_t>& counter, int64_t value) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value,
+                          std::memory_order_relaxed);
+        }
+    };
+
+    /// Snapshot of the worker's counters
+    struct Worker
+    {
+        double busy_time; ///< seconds spent in the tasks
+        double idle_time; ///< seconds spent without tasks
+        double blocked_time; ///< seconds blocked inside the tasks
+        size_t tasks_count;
+        size_t max_queue_depth;
+    };
+
+    /**
+     * @brief Ctor from workers count
+     * @param workers_cnt Number of workers
+     */
+    explicit WmExecutorMetrics(size_t workers_cnt):
+        workers_cnt_{ workers_cnt },
+        counters_{ std::make_unique<Counters[]>(workers_cnt) }
+    {}
+
+    /**
+     * @brief Returns nanoseconds of the monotonic clock
+     */
+    static int64_t now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Returns counters the calling thread reports blocking to
+     * Is nullptr for the threads which are not workers.
+     */
+    static Counters*& current() noexcept
+    {
+        static thread_local Counters* counters = nullptr;
+        return counters;
+    }
+
+    /**
+     * @brief Returns number of workers
+     */
+    size_t workers_count() const noexcept
+    {
+        return workers_cnt_;
+    }
+
+    /**
+     * @brief Returns counters of the worker
+     * @param worker_idx Worker's index
+     */
+    Counters& worker(size_t worker_idx) noexcept
+    {
+        return counters_[worker_idx];
+    }
+
+    /**
+     * @brief Returns current values of all the counters
+     */
+    std::vector<Worker> snapshot() const
+    {
+        static constexpr double NNanoseconds = 1e9;
+
+        std::vector<Worker> workers(workers_cnt_);
+        for (size_t idx = 0; idx < workers_cnt_; ++idx)
+        {
+            const Counters& counters = counters_[idx];
+
+            workers[idx] = {
+                counters.busy_ns.load(std::memory_order_relaxed) /
+                    NNanoseconds,
+                counters.idle_ns.load(std::memory_order_relaxed) /
+                    NNanoseconds,
+                counters.blocked_ns.load(std::memory_order_relaxed) /
+                    NNanoseconds,
+                counters.tasks.load(std::memory_order_relaxed),
+                counters.max_queue_depth.load(std::memory_order_relaxed)
+            };
+        }
+
+        return workers;
+    }
+
+    /**
+     * @brief Prints snapshot of the counters per worker and in total
+     * @param stream Output stream
+     */
+    template<typename TStream>
+    TStream& report(TStream& stream) const
+    {
+        std::vector<Worker> workers = snapshot();
+
+        Worker total = { 0.0, 0.0, 0.0, 0, 0 };
+        for (const Worker& worker : workers)
+        {
+            total.busy_time += worker.busy_time;
+            total.idle_time += worker.idle_time;
+            total.blocked_time += worker.blocked_time;
+            total.tasks_count += worker.tasks_count;
+            total.max_queue_depth =
+                std::max(total.max_queue_depth, worker.max_queue_depth);
+        }
+
+        for (size_t idx = 0; idx <= workers.size(); ++idx)
+        {
+            const Worker& worker = idx < workers.size() ? workers[idx] : total;
+
+            if (idx < workers.size())
+                stream << "worker " << idx;
+            else
+                stream << "total";
+
+            stream << " busy: " << worker.busy_time
+                   << " idle: " << worker.idle_time
+                   << " blocked: " << worker.blocked_time
+                   << " tasks: " << worker.tasks_count
+                   << " max depth: " << worker.max_queue_depth << '\n';
+        }
+
+        return stream;
+    }
+
+private:
+    size_t workers_cnt_ = 0;
+    std::unique_ptr<Counters[]> counters_;
+};
+
+/**
+ * @brief Accounts its lifetime as the worker's blocked time
+ * Wraps waits on the synchronization primitives,
+ * does nothing on the threads which are not executor workers.
+ */
+class WmBlockedScope
+{
+public:
+    WmBlockedScope() noexcept:
+        counters_{ WmExecutorMetrics::current() },
+        start_{ counters_ ? WmExecutorMetrics::now() : 0 }
+    {}
+
+    WmBlockedScope             (const WmBlockedScope&) = delete;
+    WmBlockedScope& operator = (const WmBlockedScope&) = delete;
+
+    ~WmBlockedScope()
+    {
+        if (counters_)
+        {
+            WmExecutorMetrics::Counters::add(counters_->blocked_ns,
+                    WmExecutorMetrics::now() - start_);
+        }
+    }
+
+private:
+    WmExecutorMetrics::Counters* counters_;
+    int64_t start_;
+};
+
+/**
+ * @brief Test structure for WmExecutorMetrics
+ */
+struct WmExecutorMetrics::Test
+{
+    template<typename TStream>
+    static TStream& test_counters(TStream& stream)
+    {
+        WmExecutorMetrics metrics(2);
+
+        metrics.worker(0).add_task(0, 1000);
+        metrics.worker(0).add_task(1000, 3000);
+        metrics.worker(1).add_idle(0, 500);
+        metrics.worker(1).observe_depth(3);
+        metrics.worker(1).observe_depth(2);
+
+        WmExecutorMetrics::current() = &metrics.worker(1);
+        {
+            WmBlockedScope blocked;
+        }
+        WmExecutorMetrics::current() = nullptr;
+
+        std::vector<Worker> workers = metrics.snapshot();
+        stream << workers[0].tasks_count << ' '
+               << workers[0].busy_time * 1e6 << ' '
+               << workers[1].idle_time * 1e6 << ' '
+               << workers[1].max_queue_depth << ' '
+               << (workers[1].blocked_time >= 0.0) << ' ';
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_EXECUTOR_METRICS_H_
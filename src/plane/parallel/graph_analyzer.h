@@ -0,0 +1,232 @@
+#ifndef WAVE_MODEL_PARALLEL_GRAPH_ANALYZER_H_
+#define WAVE_MODEL_PARALLEL_GRAPH_ANALYZER_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "grid_graph.h"
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Estimates parallel properties of the grid graph
+ * Takes per-node costs (modeled or measured) and reports total work,
+ * span (the heaviest dependency chain) and available parallelism,
+ * and simulates list scheduling of the graph on the given threads count.
+ * Allows to choose cell and tile ranks without running the benchmarks.
+ * Graph order must be topological.
+ */
+class WmGraphAnalyzer
+{
+public:
+    struct Test;
+
+    /**
+     * @brief Ctor from the grid graph and node costs
+     * Costs are repeated periodically if there are fewer of them
+     * than nodes (e.g. costs of one window for the pipeline graph).
+     * @param graph Grid graph (graph[idx] lists the nodes idx depends on)
+     * @param costs Costs of the nodes (in any units)
+     */
+    WmGraphAnalyzer(const WmGridGraph& graph, const std::vector<double>& costs):
+        graph_(graph),
+        costs_(graph.count, 0.0),
+        levels_(graph.count, 0.0),
+        positions_(graph.count, 0),
+        successors_{ wm_successors_graph(graph) }
+    {
+        for (size_t idx = 0; idx < graph_.count && !costs.empty(); ++idx)
+            costs_[idx] = costs[idx % costs.size()];
+
+        for (size_t pos = 0; pos < graph_.order.size(); ++pos)
+            positions_[graph_.order[pos]] = pos;
+
+        for (size_t idx = 0; idx < graph_.count; ++idx)
+            work_ += costs_[idx];
+
+        // the heaviest chain starting at the node (weighted bottom level)
+        for (auto it = std::rbegin(graph_.order);
+             it != std::rend(graph_.order); ++it)
+        {
+            levels_[*it] += costs_[*it];
+            span_ = std::max(span_, levels_[*it]);
+
+            for (size_t dependency : graph_.dependencies(*it))
+            {
+                levels_[dependency] =
+                    std::max(levels_[dependency], levels_[*it]);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns total cost of all the nodes (T1)
+     */
+    double work() const noexcept
+    {
+        return work_;
+    }
+
+    /**
+     * @brief Returns cost of the heaviest dependency chain (T-infinity)
+     */
+    double span() const noexcept
+    {
+        return span_;
+    }
+
+    /**
+     * @brief Returns available parallelism (work / span)
+     */
+    double parallelism() const noexcept
+    {
+        return span_ > 0.0 ? work_ / span_ : 0.0;
+    }
+
+    /**
+     * @brief Simulates list scheduling on threads_cnt threads
+     * Idle thread takes the ready node with the heaviest remaining chain
+     * (ties are broken by the graph order), scheduling overheads
+     * are not modeled. Result is bounded by max(work / threads, span).
+     * @param threads_cnt Number of threads
+     * @return Simulated makespan
+     */
+    double simulate(size_t threads_cnt) const
+    {
+        using TRunning = std::pair<double, size_t>; // finish time, node
+
+        auto ready_less = [this](size_t lhs, size_t rhs) {
+                return levels_[lhs] != levels_[rhs] ?
+                       levels_[lhs] < levels_[rhs] :
+                       positions_[lhs] > positions_[rhs];
+            };
+
+        std::priority_queue<size_t, std::vector<size_t>,
+                            decltype(ready_less)> ready(ready_less);
+        std::priority_queue<TRunning, std::vector<TRunning>,
+                            std::greater<TRunning>> running;
+
+        std::vector<size_t> in_degrees(graph_.count, 0);
+        for (size_t idx = 0; idx < graph_.count; ++idx)
+        {
+            in_degrees[idx] = graph_.dependencies(idx).size();
+            if (in_degrees[idx] == 0)
+                ready.push(idx);
+        }
+
+        double time = 0.0;
+        size_t idle_cnt = std::max<size_t>(threads_cnt, 1);
+
+        while (!ready.empty() || !running.empty())
+        {
+            for (; idle_cnt > 0 && !ready.empty(); --idle_cnt)
+            {
+                running.push({ time + costs_[ready.top()], ready.top() });
+                ready.pop();
+            }
+
+            // all the nodes finishing at the same time release threads at once
+            time = running.top().first;
+            while (!running.empty() && running.top().first == time)
+            {
+                for (size_t successor :
+                     successors_.dependencies(running.top().second))
+                {
+                    if (--in_degrees[successor] == 0)
+                        ready.push(successor);
+                }
+
+                running.pop();
+                ++idle_cnt;
+            }
+        }
+
+        return time;
+    }
+
+    /**
+     * @brief Prints the metrics and simulated scaling up to max_threads
+     * Threads counts are the powers of two.
+     * @param stream Output stream
+     * @param max_threads Maximum number of threads to simulate
+     */
+    template<typename TStream>
+    TStream& report(TStream& stream, size_t max_threads) const
+    {
+        stream << "nodes: " << graph_.count
+               << " work: " << work_
+               << " span: " << span_
+               << " parallelism: " << parallelism() << '\n';
+
+        for (size_t threads_cnt = 1; threads_cnt <= max_threads;
+             threads_cnt *= 2)
+        {
+            double makespan = simulate(threads_cnt);
+            double speedup = makespan > 0.0 ? work_ / makespan : 0.0;
+
+            stream << "threads: " << threads_cnt
+                   << " time: " << makespan
+                   << " speedup: " << speedup
+                   << " efficiency: " << speedup / threads_cnt << '\n';
+        }
+
+        return stream;
+    }
+
+private:
+    WmGridGraph graph_;
+    std::vector<double> costs_;
+    std::vector<double> levels_;
+    std::vector<size_t> positions_;
+    WmGridGraph successors_;
+
+    double work_ = 0.0;
+    double span_ = 0.0;
+};
+
+/**
+ * @brief Test structure for WmGraphAnalyzer
+ */
+struct WmGraphAnalyzer::Test
+{
+    template<typename TStream>
+    static TStream& test_init(TStream& stream)
+    {
+        WmGridGraph graph = { 0, {}, {} };
+        WmGraphAnalyzer analyzer(graph, {});
+
+        return stream;
+    }
+
+    template<typename TStream>
+    static TStream& test_metrics(TStream& stream)
+    {
+        // 0 <- 1 <- 3
+        //  ^-- 2 <-/
+        WmGridGraph graph = {
+            4, { 0, 1, 2, 3 }, { {}, { 0 }, { 0 }, { 1, 2 } }
+        };
+        WmGraphAnalyzer analyzer(graph, { 1.0, 2.0, 3.0, 1.0 });
+
+        stream << analyzer.work() << ' ' << analyzer.span() << ' '
+               << analyzer.simulate(1) << ' ' << analyzer.simulate(2) << ' ';
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_GRAPH_ANALYZER_H_
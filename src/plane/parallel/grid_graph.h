@@ -8,6 +8,8 @@
  */
 
 #include <vector>
+#include <utility>
+#include <algorithm>
 #include <cstdint>
 
 /// @brief
@@ -16,14 +18,124 @@ namespace wave_model {
 /**
  * @brief Describes structure of some grid
  * Provides dependency graph and sequential traverse order.
+ * Dependencies are stored in compressed sparse row form:
+ * the ones of vertex idx are edges[offsets[idx]..offsets[idx + 1]).
  */
 struct WmGridGraph
 {
-    size_t count; ///< vertex count
-    std::vector<size_t> order; ///< possible sequential traverse order
-    std::vector<std::vector<size_t>> graph; ///< dependency graph
+    /// Contiguous range of vertex dependencies
+    struct EdgeRange
+    {
+        const size_t* first;
+        const size_t* last;
+
+        const size_t* begin() const noexcept { return first; }
+        const size_t* end() const noexcept { return last; }
+
+        size_t size() const noexcept
+        {
+            return static_cast<size_t>(last - first);
+        }
+    };
+
+    /**
+     * @brief Default ctor
+     * Produces empty graph.
+     */
+    WmGridGraph() = default;
+
+    /**
+     * @brief Ctor from the dependency lists
+     * @param vertex_cnt Vertex count
+     * @param traverse_order Possible sequential traverse order
+     * @param lists Dependency list per vertex
+     */
+    WmGridGraph(size_t vertex_cnt, std::vector<size_t> traverse_order,
+                const std::vector<std::vector<size_t>>& lists):
+        count{ vertex_cnt },
+        order{ std::move(traverse_order) },
+        offsets(1, 0)
+    {
+        offsets.reserve(count + 1);
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            edges.insert(std::end(edges),
+                         std::begin(lists[idx]), std::end(lists[idx]));
+            offsets.push_back(edges.size());
+        }
+    }
+
+    /**
+     * @brief Returns dependencies of the vertex
+     * @param idx Vertex index
+     */
+    EdgeRange dependencies(size_t idx) const noexcept
+    {
+        return { edges.data() + offsets[idx], edges.data() + offsets[idx + 1] };
+    }
+
+    size_t count = 0; ///< vertex count
+    std::vector<size_t> order{}; ///< possible sequential traverse order
+    std::vector<size_t> offsets{ 0 }; ///< first edge per vertex (and the end)
+    std::vector<size_t> edges{}; ///< dependencies of all vertices
 };
 
+/**
+ * @brief Computes the longest remaining path of each vertex
+ * Is the number of vertices on the longest chain of dependent vertices
+ * starting at the vertex, so the vertices on the critical path have
+ * the greatest values. Graph order must be topological.
+ * @param graph Grid graph
+ * @return Longest remaining path length per vertex
+ */
+inline std::vector<size_t> wm_critical_path_lengths(const WmGridGraph& graph)
+{
+    std::vector<size_t> lengths(graph.count, 1);
+
+    for (auto it = std::rbegin(graph.order); it != std::rend(graph.order); ++it)
+    {
+        for (size_t dependency : graph.dependencies(*it))
+        {
+            lengths[dependency] =
+                std::max(lengths[dependency], lengths[*it] + 1);
+        }
+    }
+
+    return lengths;
+}
+
+/**
+ * @brief Builds the graph of successors
+ * Vertex's dependencies in the result are the vertices depending on it,
+ * listed in increasing order. Traverse order is kept as is.
+ * @param graph Grid graph
+ * @return Successors graph
+ */
+inline WmGridGraph wm_successors_graph(const WmGridGraph& graph)
+{
+    WmGridGraph successors = {};
+    successors.count = graph.count;
+    successors.order = graph.order;
+    successors.offsets.assign(graph.count + 1, 0);
+    successors.edges.resize(graph.edges.size());
+
+    for (size_t dependency : graph.edges)
+        ++successors.offsets[dependency + 1];
+
+    for (size_t idx = 0; idx < graph.count; ++idx)
+        successors.offsets[idx + 1] += successors.offsets[idx];
+
+    std::vector<size_t> positions(std::begin(successors.offsets),
+                                  std::end(successors.offsets) - 1);
+    for (size_t idx = 0; idx < graph.count; ++idx)
+    {
+        for (size_t dependency : graph.dependencies(idx))
+            successors.edges[positions[dependency]++] = idx;
+    }
+
+    return successors;
+}
+
 } // namespace wave_model
 
 #endif // GRID_GRAPH_H_
@@ -0,0 +1,115 @@
+#ifndef WAVE_MODEL_PARALLEL_HYBRID_MUTEX_H_
+#define WAVE_MODEL_PARALLEL_HYBRID_MUTEX_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "parking.h"
+#include "executor_metrics.h"
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+#include <cstdint>
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Mutex spinning adaptively before parking
+ * Is the three-state futex mutex (unlocked, locked, locked with waiters),
+ * so unlock makes a syscall only if somebody is parked.
+ * Meets Lockable requirements, replaces WmOpenMPMutex out of OpenMP code.
+ */
+class WmHybridMutex
+{
+public:
+    struct Test;
+
+    WmHybridMutex() = default;
+
+    WmHybridMutex             (const WmHybridMutex&) = delete;
+    WmHybridMutex& operator = (const WmHybridMutex&) = delete;
+
+    void lock() noexcept
+    {
+        if (try_lock() || spin_.spin([this]() { return try_lock(); }))
+            return;
+
+        WmBlockedScope blocked;
+
+        // the waking owner can't tell whether others are parked too
+        while (state_.exchange(STATE_CONTENDED,
+                               std::memory_order_acquire) != STATE_UNLOCKED)
+            WmParkingLot::wait(state_, STATE_CONTENDED);
+    }
+
+    bool try_lock() noexcept
+    {
+        int32_t state = STATE_UNLOCKED;
+        return state_.compare_exchange_strong(state, STATE_LOCKED,
+                std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        if (state_.exchange(STATE_UNLOCKED, std::memory_order_release) ==
+            STATE_CONTENDED)
+            WmParkingLot::wake(state_, 1);
+    }
+
+private:
+    enum EState : int32_t
+    {
+        STATE_UNLOCKED, STATE_LOCKED, STATE_CONTENDED
+    };
+
+    std::atomic<int32_t> state_{ STATE_UNLOCKED };
+    WmAdaptiveSpin spin_{};
+};
+
+/**
+ * @brief Test structure for WmHybridMutex
+ */
+struct WmHybridMutex::Test
+{
+    template<typename TStream>
+    static TStream& test_lock(TStream& stream)
+    {
+        static constexpr size_t NThreadsCount = 4;
+        static constexpr size_t NIncrementsCount = 10000;
+
+        WmHybridMutex mutex;
+        size_t counter = 0;
+
+        std::vector<std::thread> threads;
+        for (size_t idx = 0; idx < NThreadsCount; ++idx)
+        {
+            threads.emplace_back([&]() {
+                    for (size_t inc = 0; inc < NIncrementsCount; ++inc)
+                    {
+                        std::unique_lock<WmHybridMutex> lock(mutex);
+                        ++counter;
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        stream << counter << ' ' << mutex.try_lock() << ' ';
+        mutex.unlock();
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_HYBRID_MUTEX_H_
@@ -0,0 +1,145 @@
+#ifndef WAVE_MODEL_PARALLEL_HYBRID_SEMAPHORE_H_
+#define WAVE_MODEL_PARALLEL_HYBRID_SEMAPHORE_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "parking.h"
+#include "executor_metrics.h"
+
+#include <vector>
+#include <atomic>
+#include <thread>
+
+#include <cstdint>
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Counting semaphore spinning adaptively before parking
+ * Uncontended acquire and release are single atomic operations,
+ * release makes a syscall only if there are parked waiters.
+ * Takes 12 bytes, so arrays of semaphores should be laid out
+ * with WmSyncArray to avoid false sharing.
+ * Must not be destroyed while release() is in progress.
+ */
+class WmHybridSemaphore
+{
+public:
+    struct Test;
+
+    /**
+     * @brief Ctor from the initial value
+     * @param value Initial value
+     */
+    explicit WmHybridSemaphore(int32_t value = 0):
+        value_{ value }
+    {}
+
+    WmHybridSemaphore             (const WmHybridSemaphore&) = delete;
+    WmHybridSemaphore& operator = (const WmHybridSemaphore&) = delete;
+
+    /**
+     * @brief Decrements the value if it's positive without blocking
+     * @return Whether the value is decremented
+     */
+    bool try_acquire() noexcept
+    {
+        int32_t value = value_.load(std::memory_order_relaxed);
+        while (value > 0)
+        {
+            if (value_.compare_exchange_weak(value, value - 1,
+                    std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Decrements the value, blocks while it's zero
+     */
+    void acquire() noexcept
+    {
+        if (try_acquire() || spin_.spin([this]() { return try_acquire(); }))
+            return;
+
+        WmBlockedScope blocked;
+
+        // pairs with release(): either it sees the waiter or we see the value
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        while (!try_acquire())
+            WmParkingLot::wait(value_, 0);
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Increments the value waking parked waiters
+     * @param update Value to be added
+     */
+    void release(int32_t update = 1) noexcept
+    {
+        value_.fetch_add(update, std::memory_order_seq_cst);
+
+        if (waiters_.load(std::memory_order_seq_cst) > 0)
+            WmParkingLot::wake(value_, update);
+    }
+
+private:
+    std::atomic<int32_t> value_{ 0 };
+    std::atomic<int32_t> waiters_{ 0 };
+    WmAdaptiveSpin spin_{};
+};
+
+/**
+ * @brief Test structure for WmHybridSemaphore
+ */
+struct WmHybridSemaphore::Test
+{
+    template<typename TStream>
+    static TStream& test_run(TStream& stream)
+    {
+        static constexpr int32_t NItemsCount = 1000;
+        static constexpr size_t NConsumersCount = 3;
+
+        WmHybridSemaphore items;
+        std::atomic<int32_t> consumed{ 0 };
+
+        std::vector<std::thread> consumers;
+        for (size_t idx = 0; idx < NConsumersCount; ++idx)
+        {
+            consumers.emplace_back([&]() {
+                    while (true)
+                    {
+                        items.acquire();
+                        if (consumed.fetch_add(1) >= NItemsCount)
+                            break;
+                    }
+                });
+        }
+
+        for (int32_t idx = 0; idx < NItemsCount; ++idx)
+            items.release();
+
+        // one stop item per consumer
+        items.release(NConsumersCount);
+
+        for (auto& consumer : consumers)
+            consumer.join();
+
+        stream << consumed.load() - static_cast<int32_t>(NConsumersCount)
+               << ' ' << items.try_acquire() << ' ';
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_HYBRID_SEMAPHORE_H_
@@ -0,0 +1,276 @@
+#ifndef WAVE_MODEL_PARALLEL_NODE_SPLITTER_H_
+#define WAVE_MODEL_PARALLEL_NODE_SPLITTER_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "task.h"
+#include "dataflow_scheduler.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Splits coarse grid nodes into their children at runtime
+ * Node is split only when the scheduler has fewer ready nodes than
+ * workers (at the start and the end of the window), so the steady state
+ * keeps the coarse grain. Split node is completed by its last child:
+ * single children are executed by the splitting thread itself,
+ * the second of the independent pair (0Y, X0) is spawned to the executor
+ * and the one finishing the pair proceeds with the rest.
+ * Split records are pooled and allocated only on the first splits.
+ * @tparam TN Node type (must provide NParts and execute_part())
+ */
+template<typename TN>
+class WmNodeSplitter
+{
+public:
+    struct Test;
+
+    using TNode = TN;
+
+    /// Number of children of the node
+    static constexpr size_t NParts = 8;
+    static constexpr size_t NStages = 6;
+
+    /// First part of each stage: XY, 0Y X0, 00 of both time halves
+    static constexpr size_t NStageFirst[NStages + 1] = { 0, 1, 3, 4, 5, 7, 8 };
+
+    /**
+     * @brief Ctor from the scheduler executing the nodes
+     * @param scheduler Scheduler to defer and complete split nodes
+     */
+    explicit WmNodeSplitter(WmDataflowScheduler& scheduler):
+        scheduler_{ scheduler }
+    {}
+
+    WmNodeSplitter             (const WmNodeSplitter&) = delete;
+    WmNodeSplitter& operator = (const WmNodeSplitter&) = delete;
+
+    /**
+     * @brief Executes the node by its children if workers are starving
+     * Must be called by the node function of the scheduler's run.
+     * @param node Node to be executed
+     * @param idx Node's index in the scheduler
+     * @param layer_idx Index of the node's first layer
+     * @return Whether the node is split (it's completed later then)
+     */
+    bool split(TNode* node, size_t idx, size_t layer_idx)
+    {
+        static_assert(TNode::NParts == NParts, 
+                      "node must have 2x2 children per time half");
+
+        if (!scheduler_.starving())
+            return false;
+
+        Split* split = acquire();
+        split->node = node;
+        split->idx = idx;
+        split->layer_idx = layer_idx;
+        split->stage = 0;
+
+        scheduler_.defer(idx);
+        proceed(split);
+
+        return true;
+    }
+
+private:
+    struct Split;
+
+    /// Task record of the spawned child
+    struct PartTask : public WmTask
+    {
+        Split* split = nullptr;
+        size_t part_idx = 0;
+    };
+
+    /// State of the split node
+    struct Split
+    {
+        WmNodeSplitter* splitter = nullptr;
+        TNode* node = nullptr;
+        size_t idx = 0;
+        size_t layer_idx = 0;
+        size_t stage = 0; ///< the next stage to start
+        std::atomic<size_t> pending{ 0 }; ///< unfinished parts of the pair
+        PartTask tasks[NParts] = {};
+    };
+
+    /**
+     * @brief Executes the stages until the pair is left to another thread
+     */
+    void proceed(Split* split)
+    {
+        while (split->stage < NStages)
+        {
+            size_t first = NStageFirst[split->stage];
+            size_t last = NStageFirst[split->stage + 1];
+            ++split->stage;
+
+            if (last - first == 1)
+            {
+                split->node->execute_part(first, split->layer_idx);
+                continue;
+            }
+
+            split->pending.store(2, std::memory_order_relaxed);
+            scheduler_.spawn(&split->tasks[first + 1]);
+
+            split->node->execute_part(first, split->layer_idx);
+            if (split->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+        }
+
+        size_t idx = split->idx;
+
+        // the record may be reused as soon as the node is completed
+        release(split);
+        scheduler_.complete(idx);
+    }
+
+    /**
+     * @brief Executes the spawned child and proceeds if it's the last one
+     */
+    static void execute_part(WmTask* task)
+    {
+        auto* part_task = static_cast<PartTask*>(task);
+        Split* split = part_task->split;
+
+        split->node->execute_part(part_task->part_idx, split->layer_idx);
+        if (split->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            split->splitter->proceed(split);
+    }
+
+    /**
+     * @brief Takes split record from the pool
+     */
+    Split* acquire()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (free_.empty())
+        {
+            splits_.push_back(std::make_unique<Split>());
+
+            Split* split = splits_.back().get();
+            split->splitter = this;
+            for (size_t part_idx = 0; part_idx < NParts; ++part_idx)
+            {
+                split->tasks[part_idx].func = &WmNodeSplitter::execute_part;
+                split->tasks[part_idx].split = split;
+                split->tasks[part_idx].part_idx = part_idx;
+            }
+
+            free_.push_back(split);
+        }
+
+        Split* split = free_.back();
+        free_.pop_back();
+
+        return split;
+    }
+
+    /**
+     * @brief Returns split record to the pool
+     */
+    void release(Split* split)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        free_.push_back(split);
+    }
+
+    WmDataflowScheduler& scheduler_;
+
+    std::mutex mutex_{};
+    std::vector<std::unique_ptr<Split>> splits_{};
+    std::vector<Split*> free_{};
+};
+
+/**
+ * @brief Test structure for WmNodeSplitter
+ * Tests use their own node, so TN may be any type (e.g. void).
+ */
+template<typename TN>
+struct WmNodeSplitter<TN>::Test
+{
+    /// Node recording the order of its parts
+    struct TestNode
+    {
+        static constexpr size_t NParts = 8;
+
+        void execute_part(size_t part_idx, size_t)
+        {
+            // predecessors of the part by stages
+            static constexpr size_t NWaitFor[NParts] = {
+                0, 1, 1, 3, 4, 5, 5, 7
+            };
+
+            for (size_t prev_idx = 0; prev_idx < NWaitFor[part_idx]; ++prev_idx)
+            {
+                if (!done[prev_idx].load())
+                    order_errors.fetch_add(1);
+            }
+
+            done[part_idx].store(true);
+        }
+
+        std::atomic<bool> done[NParts] = {};
+        std::atomic<size_t> order_errors{ 0 };
+    };
+
+    template<typename TExecutor, typename TStream>
+    static TStream& test_split(TStream& stream)
+    {
+        // 0 <- 1
+        WmGridGraph graph = { 2, { 0, 1 }, { {}, { 0 } } };
+        WmDataflowScheduler scheduler(graph);
+        WmNodeSplitter<TestNode> splitter(scheduler);
+
+        TestNode nodes[2];
+        std::atomic<size_t> split_cnt{ 0 };
+
+        TExecutor executor;
+        scheduler.run(executor, [&](size_t idx) {
+                if (idx == 1)
+                {
+                    for (size_t part_idx = 0; part_idx < NParts; ++part_idx)
+                    {
+                        if (!nodes[0].done[part_idx].load())
+                            nodes[1].order_errors.fetch_add(1);
+                    }
+                }
+
+                if (splitter.split(&nodes[idx], idx, 0))
+                {
+                    split_cnt.fetch_add(1);
+                    return;
+                }
+
+                for (size_t part_idx = 0; part_idx < NParts; ++part_idx)
+                    nodes[idx].execute_part(part_idx, 0);
+            });
+
+        // the only worker is never starving
+        stream << (split_cnt.load() == (executor.metrics()
+                                        .workers_count() > 1 ? 2 : 0)) << ' '
+               << nodes[0].order_errors.load() +
+                  nodes[1].order_errors.load() << ' ';
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_NODE_SPLITTER_H_
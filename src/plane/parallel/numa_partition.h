@@ -0,0 +1,148 @@
+#ifndef WAVE_MODEL_PARALLEL_NUMA_PARTITION_H_
+#define WAVE_MODEL_PARALLEL_NUMA_PARTITION_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "affinity.h"
+
+#include <vector>
+#include <algorithm>
+
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Splits domain rows into strips owned by the executor workers
+ * Workers are ordered by their packages (sockets), so each package owns
+ * one contiguous strip of rows made of its workers' sub-strips.
+ * Rows are meant to be first touched and processed by their owners.
+ */
+class WmNumaPartition
+{
+public:
+    struct Test;
+
+    /**
+     * @brief Ctor from the executor placement
+     * @param workers_cnt Number of executor workers
+     * @param affinity Policy the executor pins its workers with
+     * @param topology Host topology
+     */
+    WmNumaPartition(size_t workers_cnt, const WmAffinityPolicy& affinity,
+                    const WmCpuTopology& topology = WmCpuTopology::detect()):
+        workers_(workers_cnt, 0)
+    {
+        std::vector<int> cpus = affinity.assign(workers_cnt, topology);
+        std::vector<int> packages(workers_cnt, 0);
+
+        for (size_t worker_idx = 0; worker_idx < workers_cnt; ++worker_idx)
+        {
+            for (const auto& info : topology.cpus)
+            {
+                if (info.cpu == cpus[worker_idx])
+                    packages[worker_idx] = info.package;
+            }
+
+            workers_[worker_idx] = worker_idx;
+        }
+
+        std::stable_sort(std::begin(workers_), std::end(workers_),
+                         [&packages](size_t lhs, size_t rhs) {
+                             return packages[lhs] < packages[rhs];
+                         });
+
+        std::sort(std::begin(packages), std::end(packages));
+        domains_cnt_ = static_cast<size_t>(
+                std::unique(std::begin(packages), std::end(packages)) -
+                std::begin(packages));
+    }
+
+    /**
+     * @brief Returns number of strips (one per worker)
+     */
+    size_t strips_count() const noexcept
+    {
+        return workers_.size();
+    }
+
+    /**
+     * @brief Returns number of NUMA domains (packages) the workers occupy
+     */
+    size_t domains_count() const noexcept
+    {
+        return domains_cnt_;
+    }
+
+    /**
+     * @brief Returns the worker owning the strip
+     * @param strip_idx Strip index
+     */
+    size_t strip_worker(size_t strip_idx) const noexcept
+    {
+        return workers_[strip_idx];
+    }
+
+    /**
+     * @brief Returns the first row of the strip
+     * @param strip_idx Strip index (strips_count() gives the end row)
+     * @param row_cnt Total number of rows
+     */
+    size_t strip_begin(size_t strip_idx, size_t row_cnt) const noexcept
+    {
+        return (strip_idx * row_cnt + workers_.size() - 1) / workers_.size();
+    }
+
+    /**
+     * @brief Returns the worker owning the row
+     * @param row_idx Row index
+     * @param row_cnt Total number of rows
+     */
+    size_t row_worker(size_t row_idx, size_t row_cnt) const noexcept
+    {
+        return workers_[row_idx * workers_.size() / row_cnt];
+    }
+
+private:
+    std::vector<size_t> workers_;
+    size_t domains_cnt_ = 0;
+};
+
+/**
+ * @brief Test structure for WmNumaPartition
+ */
+struct WmNumaPartition::Test
+{
+    template<typename TStream>
+    static TStream& test_strips(TStream& stream)
+    {
+        static constexpr size_t NRowCnt = 10;
+
+        // 2 packages x 2 cores
+        WmCpuTopology topology;
+        for (int cpu = 0; cpu < 4; ++cpu)
+            topology.cpus.push_back({ cpu, cpu / 2, cpu, cpu, cpu / 2 });
+
+        WmNumaPartition partition(
+                4, { WmAffinityPolicy::AFFINITY_SCATTER, {} }, topology);
+
+        stream << partition.domains_count() << ": ";
+        for (size_t row_idx = 0; row_idx < NRowCnt; ++row_idx)
+            stream << partition.row_worker(row_idx, NRowCnt) << ' ';
+
+        stream << "/ ";
+        for (size_t idx = 0; idx <= partition.strips_count(); ++idx)
+            stream << partition.strip_begin(idx, NRowCnt) << ' ';
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_NUMA_PARTITION_H_
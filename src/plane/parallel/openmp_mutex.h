@@ -7,6 +7,8 @@
  * @version 2.0
  */
 
+#include "executor_metrics.h"
+
 #if defined(_OPENMP)
     #include <omp.h> 
 #endif // _OPENMP
@@ -41,6 +43,7 @@ public:
 
     void lock()
     {
+        WmBlockedScope blocked;
         omp_set_lock(&lock_);
     }
 
@@ -0,0 +1,174 @@
+#ifndef WAVE_MODEL_PARALLEL_PARKING_H_
+#define WAVE_MODEL_PARALLEL_PARKING_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <condition_variable>
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif // __linux__
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#endif // defined(__x86_64__) || defined(__i386__)
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Hints the CPU that the thread is spinning
+ */
+inline void wm_cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif // defined(__x86_64__) || defined(__i386__)
+}
+
+/**
+ * @brief Parks threads on the address of the 32-bit atomic word
+ * Is implemented with private futexes on Linux and with the table
+ * of condition variables hashed by the address elsewhere.
+ * Waiters may wake spuriously, so the word must be rechecked.
+ */
+class WmParkingLot
+{
+public:
+    // allow only namespace-like usage
+    WmParkingLot() = delete;
+
+    /// Number of buckets of the fallback table
+    static constexpr size_t NBuckets = 64;
+
+    static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t),
+                  "atomic word must be layout-compatible with futex");
+
+    /**
+     * @brief Blocks while the word is equal to expected
+     * @param word Atomic word to park on
+     * @param expected Value of the word to sleep on
+     */
+    static void wait(std::atomic<int32_t>& word, int32_t expected) noexcept
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<int32_t*>(&word),
+                FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+
+#else // __linux__
+        Bucket& bucket = bucket_of(&word);
+
+        std::unique_lock<std::mutex> lock(bucket.mutex);
+        if (word.load(std::memory_order_seq_cst) == expected)
+            bucket.cond_var.wait(lock);
+
+#endif // __linux__
+    }
+
+    /**
+     * @brief Wakes threads parked on the word
+     * Must be called after the word is changed.
+     * @param word Atomic word the threads are parked on
+     * @param count Maximal number of threads to wake
+     */
+    static void wake(std::atomic<int32_t>& word, int32_t count) noexcept
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<int32_t*>(&word),
+                FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+
+#else // __linux__
+        static_cast<void>(count);
+        Bucket& bucket = bucket_of(&word);
+
+        // bucket is shared by many words, so everyone rechecks its own
+        std::unique_lock<std::mutex> lock(bucket.mutex);
+        bucket.cond_var.notify_all();
+
+#endif // __linux__
+    }
+
+private:
+#if !defined(__linux__)
+    struct alignas(64) Bucket
+    {
+        std::mutex mutex{};
+        std::condition_variable cond_var{};
+    };
+
+    static Bucket& bucket_of(const void* address) noexcept
+    {
+        static Bucket buckets[NBuckets];
+
+        auto key = reinterpret_cast<uintptr_t>(address) / sizeof(int32_t);
+        return buckets[key % NBuckets];
+    }
+
+#endif // !defined(__linux__)
+};
+
+/**
+ * @brief Adaptive number of spins before parking
+ * Limit is doubled when spinning pays off and halved when
+ * the thread has to park anyway. Spinning is skipped on the
+ * single CPU, where the awaited thread can't run meanwhile.
+ */
+class WmAdaptiveSpin
+{
+public:
+    static constexpr int32_t NMinSpins = 16;
+    static constexpr int32_t NMaxSpins = 4096;
+
+    /**
+     * @brief Spins until pred() is true or the limit is exhausted
+     * @tparam TPred Predicate type
+     * @param pred Predicate trying to take the resource
+     * @return Whether pred() has succeeded
+     */
+    template<typename TPred>
+    bool spin(TPred&& pred) noexcept
+    {
+        static const bool NSingleCpu =
+            std::thread::hardware_concurrency() == 1;
+
+        if (NSingleCpu)
+            return false;
+
+        int32_t limit = limit_.load(std::memory_order_relaxed);
+        for (int32_t spin_idx = 0; spin_idx < limit; ++spin_idx)
+        {
+            if (pred())
+            {
+                limit_.store(std::min(limit * 2, NMaxSpins),
+                             std::memory_order_relaxed);
+                return true;
+            }
+
+            wm_cpu_relax();
+        }
+
+        limit_.store(std::max(limit / 2, NMinSpins),
+                     std::memory_order_relaxed);
+        return false;
+    }
+
+private:
+    std::atomic<int32_t> limit_{ NMinSpins };
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_PARKING_H_
@@ -0,0 +1,274 @@
+#ifndef WAVE_MODEL_PARALLEL_PRIORITY_EXECUTOR_H_
+#define WAVE_MODEL_PARALLEL_PRIORITY_EXECUTOR_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "abstract_executor.h"
+#include "task.h"
+#include "affinity.h"
+#include "logging/trace.h"
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Thread pool executing tasks in the order of their priorities
+ * Tasks are kept in the single binary heap by WmTask::priority,
+ * tasks of the same priority are executed in FIFO order.
+ * Grid nodes get their longest remaining path as priority
+ * (see WmDataflowScheduler), so the critical path is never delayed
+ * by the work which unblocks nothing.
+ */
+class WmPriorityExecutor final : public WmAbstractExecutor
+{
+public:
+    struct Test;
+
+    /// Default threads count
+    static constexpr size_t NDefaultConcurrency = 4;
+
+    /**
+     * @brief Ctor from threads count
+     * @param workers_cnt Count of threads to be created
+     * @param affinity Policy of pinning threads to CPUs
+     */
+    explicit WmPriorityExecutor(size_t workers_cnt =
+            std::thread::hardware_concurrency(),
+            const WmAffinityPolicy& affinity = {}):
+        metrics_{ workers_cnt == 0 ? NDefaultConcurrency : workers_cnt }
+    {
+        if (workers_cnt == 0)
+            workers_cnt = NDefaultConcurrency;
+
+        std::vector<int> cpus(workers_cnt, -1);
+        if (affinity.kind != WmAffinityPolicy::AFFINITY_NONE)
+            cpus = affinity.assign(workers_cnt, WmCpuTopology::detect());
+
+        for (size_t worker_idx = 0; worker_idx < workers_cnt; ++worker_idx)
+        {
+            workers_.emplace_back([this, worker_idx, cpu = cpus[worker_idx]]() {
+                    wm_pin_current_thread(cpu);
+                    WM_TRACE_THREAD("priority", worker_idx);
+                    work(worker_idx);
+                });
+        }
+    }
+
+    /**
+     * @brief Dtor
+     * Waits for the heap to be empty and joins all threads
+     */
+    ~WmPriorityExecutor() override final
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+
+        cond_var_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    /**
+     * @brief Adds task of the lowest priority
+     * @param func Task to be enqueued
+     * Is kept for compatibility: allocates record owning the function.
+     * @see WmAbstractExecutor::enqueue()
+     */
+    void enqueue(std::function<void()> func) override final
+    {
+        enqueue(new WmFunctionTask(std::move(func)));
+    }
+
+    /**
+     * @brief Adds task record to the heap
+     * @param task Task record to be enqueued
+     * @see WmAbstractExecutor::enqueue()
+     */
+    void enqueue(WmTask* task) override final
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        push(task);
+
+        lock.unlock();
+        cond_var_.notify_one();
+    }
+
+    /**
+     * @brief Adds batch of task records to the heap at once
+     * @param tasks Task records array
+     * @param count Number of records
+     * @see WmAbstractExecutor::enqueue_batch()
+     */
+    void enqueue_batch(WmTask* const* tasks, size_t count) override final
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (size_t idx = 0; idx < count; ++idx)
+            push(tasks[idx]);
+
+        lock.unlock();
+        cond_var_.notify_all();
+    }
+
+    /**
+     * @brief Returns per-worker counters
+     * @see WmAbstractExecutor::metrics()
+     */
+    const WmExecutorMetrics& metrics() const noexcept override final
+    {
+        return metrics_;
+    }
+
+private:
+    /// Heap entry (sequence number keeps FIFO order among equal priorities)
+    struct Entry
+    {
+        size_t priority;
+        size_t seq;
+        WmTask* task;
+
+        bool operator < (const Entry& other) const noexcept
+        {
+            return priority != other.priority ?
+                   priority < other.priority : seq > other.seq;
+        }
+    };
+
+    /**
+     * @brief Pushes task to the heap (must be called under the lock)
+     */
+    void push(WmTask* task)
+    {
+        heap_.push_back({ task->priority, seq_++, task });
+        std::push_heap(std::begin(heap_), std::end(heap_));
+    }
+
+    /**
+     * @brief Worker thread main loop
+     * Exits when stopped and there are no more tasks to execute.
+     */
+    void work(size_t worker_idx)
+    {
+        auto& counters = metrics_.worker(worker_idx);
+        WmExecutorMetrics::current() = &counters;
+
+        int64_t idle_start = WmExecutorMetrics::now();
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_var_.wait(lock, [this]() -> bool {
+                    return !heap_.empty() || stopped_;
+                });
+
+            if (heap_.empty() && stopped_)
+                break;
+
+            counters.observe_depth(heap_.size());
+
+            std::pop_heap(std::begin(heap_), std::end(heap_));
+            WmTask* task = heap_.back().task;
+            heap_.pop_back();
+
+            lock.unlock();
+
+            int64_t start = WmExecutorMetrics::now();
+            counters.add_idle(idle_start, start);
+
+            task->execute();
+
+            idle_start = WmExecutorMetrics::now();
+            counters.add_task(start, idle_start);
+        }
+
+        WmExecutorMetrics::current() = nullptr;
+    }
+
+    bool stopped_ = false;
+    size_t seq_ = 0;
+
+    WmExecutorMetrics metrics_;
+
+    std::mutex mutex_{};
+    std::condition_variable cond_var_{};
+
+    std::vector<std::thread> workers_;
+    std::vector<Entry> heap_;
+};
+
+/**
+ * @brief Test structure for WmPriorityExecutor
+ */
+struct WmPriorityExecutor::Test
+{
+    template<typename TStream>
+    static TStream& test_init(TStream& stream)
+    {
+        static constexpr size_t NDefaultConcurrency =
+            WmPriorityExecutor::NDefaultConcurrency;
+
+        WmPriorityExecutor executor(NDefaultConcurrency);
+
+        return stream;
+    }
+
+    template<typename TStream>
+    static TStream& test_order(TStream& stream)
+    {
+        struct OrderTask : public WmTask
+        {
+            std::vector<size_t>* order = nullptr;
+        };
+
+        std::vector<size_t> order;
+        std::atomic<bool> released{ false };
+
+        OrderTask tasks[4] = {};
+        WmTask* task_ptrs[4] = {};
+
+        size_t priorities[4] = { 1, 3, 2, 3 };
+        for (size_t idx = 0; idx < 4; ++idx)
+        {
+            tasks[idx].func = [](WmTask* task) {
+                    auto* self = static_cast<OrderTask*>(task);
+                    self->order->push_back(self->priority);
+                };
+            tasks[idx].priority = priorities[idx];
+            tasks[idx].order = &order;
+            task_ptrs[idx] = &tasks[idx];
+        }
+
+        {
+            // the only worker is held until the whole batch is enqueued
+            WmPriorityExecutor executor(1);
+            executor.enqueue([&released]() {
+                    while (!released.load())
+                        std::this_thread::yield();
+                });
+
+            executor.enqueue_batch(task_ptrs, 4);
+            released.store(true);
+        }
+
+        for (size_t priority : order)
+            stream << priority << ' ';
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_PRIORITY_EXECUTOR_H_
@@ -31,13 +31,96 @@ public:
 
     /**
      * @brief Immediately executes the task and bloks until executed
+     * Tasks enqueued from inside the running task are deferred until 
+     * it is finished to keep the stack depth bounded for long task chains.
      * @param func Task to be executed
      * @see WmAbstractExecutor::enqueue()
      */
     void enqueue(std::function<void()> func) override final
     {
+        if (running_)
+        {
+            enqueue(new WmFunctionTask(std::move(func)));
+            return;
+        }
+
+        running_ = true;
+
+        int64_t start = WmExecutorMetrics::now();
         std::move(func)();
+        metrics_.worker(0).add_task(start, WmExecutorMetrics::now());
+
+        run_deferred();
+    }
+
+    /**
+     * @brief Immediately executes the task record and bloks until executed
+     * @param task Task record to be executed
+     * @see WmAbstractExecutor::enqueue()
+     */
+    void enqueue(WmTask* task) override final
+    {
+        if (running_)
+        {
+            task->next = nullptr;
+            if (deferred_tail_)
+                deferred_tail_->next = task;
+            else
+                deferred_head_ = task;
+
+            deferred_tail_ = task;
+            ++deferred_depth_;
+            return;
+        }
+
+        running_ = true;
+
+        int64_t start = WmExecutorMetrics::now();
+        task->execute();
+        metrics_.worker(0).add_task(start, WmExecutorMetrics::now());
+
+        run_deferred();
+    }
+
+    /**
+     * @brief Returns counters of the calling thread as the only worker
+     * @see WmAbstractExecutor::metrics()
+     */
+    const WmExecutorMetrics& metrics() const noexcept override final
+    {
+        return metrics_;
     }
+
+private:
+    /**
+     * @brief Executes deferred tasks in FIFO order
+     */
+    void run_deferred()
+    {
+        while (deferred_head_)
+        {
+            WmTask* task = deferred_head_;
+
+            deferred_head_ = task->next;
+            if (!deferred_head_)
+                deferred_tail_ = nullptr;
+
+            metrics_.worker(0).observe_depth(deferred_depth_--);
+
+            int64_t start = WmExecutorMetrics::now();
+            task->execute();
+            metrics_.worker(0).add_task(start, WmExecutorMetrics::now());
+        }
+
+        running_ = false;
+    }
+
+    bool running_ = false;
+    WmTask* deferred_head_ = nullptr;
+    WmTask* deferred_tail_ = nullptr;
+    size_t deferred_depth_ = 0;
+
+    WmExecutorMetrics metrics_{ 1 };
 };
 
 /**
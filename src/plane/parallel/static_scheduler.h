@@ -0,0 +1,300 @@
+#ifndef WAVE_MODEL_PARALLEL_STATIC_SCHEDULER_H_
+#define WAVE_MODEL_PARALLEL_STATIC_SCHEDULER_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "grid_graph.h"
+#include "affinity.h"
+#include "executor_metrics.h"
+#include "logging/trace.h"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <type_traits>
+
+#include <cstdint>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Executes grid nodes by the static per-thread schedule
+ * Nodes are split into wavefronts (by the longest dependency chain)
+ * and each wavefront is distributed between threads cyclically
+ * before the first run. Threads walk their own lists and wait only
+ * for the completion flags of the node's dependencies,
+ * so the run involves no queues, no semaphores and no executor.
+ * Graph order must be topological.
+ */
+class WmStaticScheduler
+{
+public:
+    struct Test;
+
+    /// Number of flag checks before yielding the thread
+    static constexpr size_t NSpinCount = 64;
+
+    /**
+     * @brief Ctor from the grid graph and threads count
+     * @param graph Grid graph (graph[idx] lists the nodes idx depends on)
+     * @param threads_cnt Number of threads (including the calling one)
+     * @param affinity Policy of pinning the worker threads to CPUs
+     */
+    WmStaticScheduler(const WmGridGraph& graph, size_t threads_cnt,
+                      const WmAffinityPolicy& affinity = {}):
+        graph_(graph),
+        lists_(std::max<size_t>(threads_cnt, 1)),
+        flags_{ std::make_unique<Flag[]>(graph.count) },
+        metrics_{ lists_.size() }
+    {
+        std::vector<size_t> levels(graph.count, 0);
+        for (size_t idx : graph.order)
+        {
+            for (size_t dependency : graph.dependencies(idx))
+                levels[idx] = std::max(levels[idx], levels[dependency] + 1);
+        }
+
+        std::vector<size_t> wavefronts = graph.order;
+        std::stable_sort(std::begin(wavefronts), std::end(wavefronts),
+                         [&levels](size_t lhs, size_t rhs) {
+                             return levels[lhs] < levels[rhs];
+                         });
+
+        // k-th node of the wavefront goes to (k % threads_cnt)-th thread
+        for (size_t pos = 0, first = 0; pos < wavefronts.size(); ++pos)
+        {
+            if (levels[wavefronts[pos]] != levels[wavefronts[first]])
+                first = pos;
+
+            lists_[(pos - first) % lists_.size()].push_back(wavefronts[pos]);
+        }
+
+        std::vector<int> cpus(lists_.size(), -1);
+        if (affinity.kind != WmAffinityPolicy::AFFINITY_NONE)
+            cpus = affinity.assign(lists_.size(), WmCpuTopology::detect());
+
+        for (size_t list_idx = 1; list_idx < lists_.size(); ++list_idx)
+        {
+            workers_.emplace_back([this, list_idx, cpu = cpus[list_idx]]() {
+                    wm_pin_current_thread(cpu);
+                    WM_TRACE_THREAD("static", list_idx);
+                    work(list_idx);
+                });
+        }
+    }
+
+    WmStaticScheduler             (const WmStaticScheduler&) = delete;
+    WmStaticScheduler& operator = (const WmStaticScheduler&) = delete;
+
+    /**
+     * @brief Dtor
+     * Stops and joins the worker threads
+     */
+    ~WmStaticScheduler()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+
+        cond_var_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    /**
+     * @brief Returns number of threads (including the calling one)
+     */
+    size_t threads_count() const noexcept
+    {
+        return lists_.size();
+    }
+
+    /**
+     * @brief Returns per-thread counters
+     * Blocked time is the time waiting for the dependencies,
+     * idle time of the workers is the time between the runs.
+     */
+    const WmExecutorMetrics& metrics() const noexcept
+    {
+        return metrics_;
+    }
+
+    /**
+     * @brief Executes func(idx) for each node respecting dependencies
+     * The calling thread executes the first list itself
+     * and returns when all the lists are done.
+     * @tparam TFunc Node function type
+     * @param func Node function
+     */
+    template<typename TFunc>
+    void run(TFunc&& func)
+    {
+        using TDecayFunc = std::remove_reference_t<TFunc>;
+
+        context_ = static_cast<void*>(&func);
+        body_ = [](void* context, size_t idx) {
+                (*static_cast<TDecayFunc*>(context))(idx);
+            };
+
+        finished_.store(0, std::memory_order_relaxed);
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ++epoch_;
+        }
+
+        cond_var_.notify_all();
+        process(0, epoch_);
+
+        while (finished_.load(std::memory_order_acquire) + 1 < lists_.size())
+            std::this_thread::yield();
+    }
+
+private:
+    /// Cache-line-aligned completion flag of the node
+    struct alignas(64) Flag
+    {
+        std::atomic<size_t> epoch{ 0 }; ///< the last run the node is done in
+    };
+
+    /**
+     * @brief Executes the list's nodes waiting for their dependencies
+     */
+    void process(size_t list_idx, size_t epoch)
+    {
+        auto& counters = metrics_.worker(list_idx);
+        auto* prev_counters = WmExecutorMetrics::current();
+        WmExecutorMetrics::current() = &counters;
+
+        for (size_t idx : lists_[list_idx])
+        {
+            int64_t start = WmExecutorMetrics::now();
+
+            for (size_t dependency : graph_.dependencies(idx))
+            {
+                for (size_t spin_cnt = 0; flags_[dependency].epoch
+                        .load(std::memory_order_acquire) != epoch; ++spin_cnt)
+                {
+                    if (spin_cnt >= NSpinCount)
+                        std::this_thread::yield();
+                }
+            }
+
+            int64_t ready = WmExecutorMetrics::now();
+            WmExecutorMetrics::Counters::add(counters.blocked_ns,
+                                             ready - start);
+
+            body_(context_, idx);
+            flags_[idx].epoch.store(epoch, std::memory_order_release);
+
+            counters.add_task(start, WmExecutorMetrics::now());
+        }
+
+        WmExecutorMetrics::current() = prev_counters;
+    }
+
+    /**
+     * @brief Worker thread main loop
+     * Sleeps between the runs, exits when stopped.
+     */
+    void work(size_t list_idx)
+    {
+        size_t epoch = 0;
+
+        while (true)
+        {
+            int64_t idle_start = WmExecutorMetrics::now();
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_var_.wait(lock, [this, epoch]() -> bool {
+                        return stopped_ || epoch_ != epoch;
+                    });
+
+                if (stopped_)
+                    break;
+
+                epoch = epoch_;
+            }
+
+            metrics_.worker(list_idx)
+                .add_idle(idle_start, WmExecutorMetrics::now());
+            process(list_idx, epoch);
+            finished_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    WmGridGraph graph_;
+    std::vector<std::vector<size_t>> lists_;
+    std::unique_ptr<Flag[]> flags_;
+    WmExecutorMetrics metrics_;
+
+    void* context_ = nullptr;
+    void (*body_)(void*, size_t) = nullptr;
+
+    std::atomic<size_t> finished_{ 0 };
+    size_t epoch_ = 0;
+    bool stopped_ = false;
+
+    std::mutex mutex_{};
+    std::condition_variable cond_var_{};
+    std::vector<std::thread> workers_{};
+};
+
+/**
+ * @brief Test structure for WmStaticScheduler
+ */
+struct WmStaticScheduler::Test
+{
+    template<typename TStream>
+    static TStream& test_init(TStream& stream)
+    {
+        WmGridGraph graph = { 0, {}, {} };
+        WmStaticScheduler scheduler(graph, 2);
+
+        return stream;
+    }
+
+    template<typename TStream>
+    static TStream& test_run(TStream& stream)
+    {
+        // 0 <- 1 <- 3
+        //  ^-- 2 <-/
+        WmGridGraph graph = {
+            4, { 0, 1, 2, 3 }, { {}, { 0 }, { 0 }, { 1, 2 } }
+        };
+        WmStaticScheduler scheduler(graph, 2);
+
+        std::atomic<size_t> done[4] = {};
+        std::atomic<size_t> order_errors{ 0 };
+
+        for (size_t run_idx = 0; run_idx < 2; ++run_idx)
+        {
+            scheduler.run([&](size_t idx) {
+                    for (size_t dependency : graph.dependencies(idx))
+                    {
+                        if (done[dependency].load() != run_idx + 1)
+                            order_errors.fetch_add(1);
+                    }
+
+                    done[idx].fetch_add(1);
+                });
+        }
+
+        stream << order_errors.load();
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_STATIC_SCHEDULER_H_
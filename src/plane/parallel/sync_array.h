@@ -0,0 +1,189 @@
+#ifndef WAVE_MODEL_PARALLEL_SYNC_ARRAY_H_
+#define WAVE_MODEL_PARALLEL_SYNC_ARRAY_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <new>
+#include <memory>
+#include <algorithm>
+
+#include <cstdint>
+#include <cstddef>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Describes layout of the synchronization primitives array
+ */
+struct WmSyncLayout
+{
+    enum EKind
+    {
+        LAYOUT_PACKED, ///< elements are adjacent (the least memory)
+        LAYOUT_PADDED, ///< each element occupies its own cache line
+        LAYOUT_STRIPED ///< neighbouring indices are on different lines
+    };
+};
+
+/**
+ * @brief Fixed-size array of synchronization primitives
+ * Neighbouring grid nodes are synchronized by different threads
+ * at the same time, so their primitives must not share cache lines.
+ * Padding gives each element a line of its own, striping keeps
+ * elements packed but places the consecutive indices on different lines
+ * (i-th element goes to the line i % lines count). Elements larger
+ * than the line get whole lines of their own in both layouts.
+ * Elements are default-constructed in place and are never moved.
+ * @tparam T Element type (e.g. WmHybridSemaphore)
+ */
+template<typename T>
+class WmSyncArray
+{
+public:
+    struct Test;
+
+    /// Assumed size of the cache line
+    static constexpr size_t NLineSize = 64;
+
+    /// Size of the element rounded up to whole cache lines
+    static constexpr size_t NPaddedSize =
+        (sizeof(T) + NLineSize - 1) / NLineSize * NLineSize;
+
+    /// Number of elements per padded slot in the striped layout
+    static constexpr size_t NPerLine = NPaddedSize / sizeof(T);
+
+    static_assert(alignof(T) <= NLineSize, "element is over-aligned");
+
+    /**
+     * @brief Ctor from elements count and layout
+     * @param count Number of elements
+     * @param layout Layout of the elements
+     */
+    WmSyncArray(size_t count, WmSyncLayout::EKind layout):
+        count_{ count },
+        layout_{ layout },
+        lines_cnt_{ (count + NPerLine - 1) / NPerLine }
+    {
+        size_t bytes = 0;
+        switch (layout_)
+        {
+            case WmSyncLayout::LAYOUT_PACKED:
+                bytes = count_ * sizeof(T); break;
+            case WmSyncLayout::LAYOUT_PADDED:
+                bytes = count_ * NPaddedSize; break;
+            case WmSyncLayout::LAYOUT_STRIPED:
+                bytes = lines_cnt_ * NPaddedSize; break;
+        }
+
+        storage_ = static_cast<unsigned char*>(::operator new(
+                std::max<size_t>(bytes, 1), std::align_val_t{ NLineSize }));
+
+        for (size_t idx = 0; idx < count_; ++idx)
+            new (storage_ + offset(idx)) T();
+    }
+
+    WmSyncArray             (const WmSyncArray&) = delete;
+    WmSyncArray& operator = (const WmSyncArray&) = delete;
+
+    ~WmSyncArray()
+    {
+        for (size_t idx = 0; idx < count_; ++idx)
+            (*this)[idx].~T();
+
+        ::operator delete(storage_, std::align_val_t{ NLineSize });
+    }
+
+    /**
+     * @brief Returns number of elements
+     */
+    size_t size() const noexcept
+    {
+        return count_;
+    }
+
+    [[nodiscard]] T& operator [] (size_t idx) noexcept
+    {
+        return *std::launder(reinterpret_cast<T*>(storage_ + offset(idx)));
+    }
+
+    [[nodiscard]] const T& operator [] (size_t idx) const noexcept
+    {
+        return *std::launder(
+                reinterpret_cast<const T*>(storage_ + offset(idx)));
+    }
+
+private:
+    /**
+     * @brief Returns offset of the element in bytes
+     */
+    size_t offset(size_t idx) const noexcept
+    {
+        switch (layout_)
+        {
+            case WmSyncLayout::LAYOUT_PACKED:
+                return idx * sizeof(T);
+            case WmSyncLayout::LAYOUT_PADDED:
+                return idx * NPaddedSize;
+            case WmSyncLayout::LAYOUT_STRIPED:
+                return (idx % lines_cnt_) * NPaddedSize +
+                       (idx / lines_cnt_) * sizeof(T);
+        }
+
+        return 0;
+    }
+
+    size_t count_ = 0;
+    WmSyncLayout::EKind layout_ = WmSyncLayout::LAYOUT_PACKED;
+    size_t lines_cnt_ = 0;
+    unsigned char* storage_ = nullptr;
+};
+
+/**
+ * @brief Test structure for WmSyncArray
+ */
+template<typename T>
+struct WmSyncArray<T>::Test
+{
+    template<typename TStream>
+    static TStream& test_layout(TStream& stream)
+    {
+        static constexpr size_t NCount = 100;
+
+        WmSyncLayout::EKind layouts[] = {
+            WmSyncLayout::LAYOUT_PACKED,
+            WmSyncLayout::LAYOUT_PADDED,
+            WmSyncLayout::LAYOUT_STRIPED
+        };
+
+        for (WmSyncLayout::EKind layout : layouts)
+        {
+            WmSyncArray<T> array(NCount, layout);
+
+            // count neighbours sharing the line
+            size_t shared_cnt = 0;
+            for (size_t idx = 0; idx + 1 < NCount; ++idx)
+            {
+                auto line = reinterpret_cast<uintptr_t>(&array[idx]) /
+                    NLineSize;
+                auto next_line = reinterpret_cast<uintptr_t>(&array[idx + 1]) /
+                    NLineSize;
+
+                if (line == next_line)
+                    ++shared_cnt;
+            }
+
+            stream << (shared_cnt > 0) << ' ';
+        }
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_SYNC_ARRAY_H_
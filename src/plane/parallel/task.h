@@ -0,0 +1,82 @@
+#ifndef WAVE_MODEL_PARALLEL_TASK_H_
+#define WAVE_MODEL_PARALLEL_TASK_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "completion.h"
+
+#include <functional>
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Intrusive task record
+ * Is meant to be embedded into preallocated objects and dispatched by
+ * plain function pointer, so enqueueing it requires neither allocation
+ * nor type erasure. Links are owned by the executor the task is queued in,
+ * hence one record can't be enqueued twice before it is executed.
+ */
+struct WmTask
+{
+    /// Task function type (receives the record itself)
+    using TFunc = void (*)(WmTask*);
+
+    /// Home value of the task without preferred worker
+    static constexpr size_t NNoHome = SIZE_MAX;
+
+    /**
+     * @brief Executes the task
+     */
+    void execute()
+    {
+        // the record may be destroyed by func itself
+        WmCompletion* task_completion = completion;
+
+        func(this);
+
+        if (task_completion)
+            task_completion->count_down();
+    }
+
+    TFunc func = nullptr; ///< task function
+    WmCompletion* completion = nullptr; ///< optional completion handle
+    WmTask* prev = nullptr; ///< executor-owned link
+    WmTask* next = nullptr; ///< executor-owned link
+    size_t home = NNoHome; ///< preferred worker index (scheduling hint)
+    size_t priority = 0; ///< higher is executed earlier (scheduling hint)
+};
+
+/**
+ * @brief Task record owning std::function
+ * Allows to pass std::function tasks through the WmTask queues.
+ * Must be allocated with new and deletes itself after execution.
+ */
+struct WmFunctionTask final : public WmTask
+{
+    explicit WmFunctionTask(std::function<void()> func_value):
+        WmTask{ &WmFunctionTask::invoke },
+        function{ std::move(func_value) }
+    {}
+
+    static void invoke(WmTask* task)
+    {
+        auto* self = static_cast<WmFunctionTask*>(task);
+
+        self->function();
+        delete self;
+    }
+
+    std::function<void()> function; ///< owned task
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_TASK_H_
@@ -8,6 +8,8 @@
  */
 
 #include "abstract_executor.h"
+#include "affinity.h"
+#include "logging/trace.h"
 
 #include <vector>
 #include <queue>
@@ -39,16 +41,30 @@ public:
     /**
      * @brief Ctor from threads count
      * @param workers_cnt Count of threads to be created
+     * @param affinity Policy of pinning threads to CPUs
      */
     explicit WmThreadPoolExecutor(size_t workers_cnt = 
-            std::thread::hardware_concurrency())
+            std::thread::hardware_concurrency(),
+            const WmAffinityPolicy& affinity = {}):
+        metrics_{ workers_cnt == 0 ? NDefaultConcurrency : workers_cnt }
     {
         if (workers_cnt == 0)
             workers_cnt = NDefaultConcurrency;
 
+        std::vector<int> cpus(workers_cnt, -1);
+        if (affinity.kind != WmAffinityPolicy::AFFINITY_NONE)
+            cpus = affinity.assign(workers_cnt, WmCpuTopology::detect());
+
         for (size_t worker_idx = 0; worker_idx < workers_cnt; ++worker_idx)
         {
-            workers_.emplace_back([this]() {
+            workers_.emplace_back([this, worker_idx, cpu = cpus[worker_idx]]() {
+                    wm_pin_current_thread(cpu);
+                    WM_TRACE_THREAD("pool", worker_idx);
+
+                    auto& counters = metrics_.worker(worker_idx);
+                    WmExecutorMetrics::current() = &counters;
+
+                    int64_t idle_start = WmExecutorMetrics::now();
                     while (true)
                     {
                         std::unique_lock<std::mutex> lock(mutex_);
@@ -59,13 +75,24 @@ public:
                         if (tasks_.empty() && stopped_) 
                             break;
 
+                        counters.observe_depth(tasks_.size());
+
                         auto task = tasks_.front();
                         tasks_.pop();
                         // ++running_;
 
                         lock.unlock();
+
+                        int64_t start = WmExecutorMetrics::now();
+                        counters.add_idle(idle_start, start);
+
                         task();
+
+                        idle_start = WmExecutorMetrics::now();
+                        counters.add_task(start, idle_start);
                     }
+
+                    WmExecutorMetrics::current() = nullptr;
                 });
         }
     }
@@ -86,6 +113,8 @@ public:
             worker.join();
     }
 
+    using WmAbstractExecutor::enqueue;
+
     /**
      * @brief Adds task to the task queue
      * @param func Task to be enqueued
@@ -101,10 +130,37 @@ public:
         cond_var_.notify_one();
     }
 
+    /**
+     * @brief Adds batch of task records to the task queue at once
+     * @param tasks Task records array
+     * @param count Number of records
+     * @see WmAbstractExecutor::enqueue_batch()
+     */
+    void enqueue_batch(WmTask* const* tasks, size_t count) override final
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (size_t idx = 0; idx < count; ++idx)
+            tasks_.push([task = tasks[idx]]() { task->execute(); });
+
+        lock.unlock();
+        cond_var_.notify_all();
+    }
+
+    /**
+     * @brief Returns per-worker counters
+     * @see WmAbstractExecutor::metrics()
+     */
+    const WmExecutorMetrics& metrics() const noexcept override final
+    {
+        return metrics_;
+    }
+
 private:
     bool stopped_ = false;
     // size_t running_ = 0;
 
+    WmExecutorMetrics metrics_;
+
     std::mutex mutex_{};
     std::condition_variable cond_var_{};
 
@@ -0,0 +1,516 @@
+#ifndef WAVE_MODEL_PARALLEL_WORK_STEALING_EXECUTOR_H_
+#define WAVE_MODEL_PARALLEL_WORK_STEALING_EXECUTOR_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "abstract_executor.h"
+#include "task.h"
+#include "affinity.h"
+#include "logging/trace.h"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Parallel executor with per-worker queues and work stealing
+ * Each worker owns its own intrusive deque of task records:
+ * tasks enqueued from inside a running task are pushed to the current
+ * worker's deque and popped back LIFO,
+ * so the freshly produced work stays in the worker's cache.
+ * Idle workers steal the oldest tasks from the other deques,
+ * spin for a while and only then park on the condition variable.
+ */
+class WmWorkStealingExecutor final : public WmAbstractExecutor
+{
+public:
+    struct Test;
+
+    /// Default threads count
+    static constexpr size_t NDefaultConcurrency = 4;
+
+    /// Number of unsuccessful search rounds before parking
+    static constexpr size_t NSpinCount = 64;
+
+    /**
+     * @brief Ctor from threads count
+     * @param workers_cnt Count of threads to be created
+     * @param affinity Policy of pinning threads to CPUs
+     * Pinned workers steal from the workers sharing their caches first.
+     */
+    explicit WmWorkStealingExecutor(size_t workers_cnt =
+            std::thread::hardware_concurrency(),
+            const WmAffinityPolicy& affinity = {}):
+        workers_cnt_{ workers_cnt == 0 ? NDefaultConcurrency : workers_cnt },
+        workers_{ std::make_unique<Worker[]>(workers_cnt_) },
+        metrics_{ workers_cnt_ }
+    {
+        std::vector<int> cpus(workers_cnt_, -1);
+        WmCpuTopology topology;
+
+        if (affinity.kind != WmAffinityPolicy::AFFINITY_NONE)
+        {
+            topology = WmCpuTopology::detect();
+            cpus = affinity.assign(workers_cnt_, topology);
+        }
+
+        for (size_t worker_idx = 0; worker_idx < workers_cnt_; ++worker_idx)
+        {
+            Worker& worker = workers_[worker_idx];
+
+            worker.cpu = cpus[worker_idx];
+            for (size_t shift = 1; shift < workers_cnt_; ++shift)
+                worker.victims.push_back((worker_idx + shift) % workers_cnt_);
+
+            auto distance = [&topology, &cpus, worker_idx](size_t victim) {
+                    return cpu_distance(topology,
+                                        cpus[worker_idx], cpus[victim]);
+                };
+
+            std::stable_sort(std::begin(worker.victims),
+                             std::end(worker.victims),
+                             [&distance](size_t lhs, size_t rhs) {
+                                 return distance(lhs) < distance(rhs);
+                             });
+        }
+
+        for (size_t worker_idx = 0; worker_idx < workers_cnt_; ++worker_idx)
+        {
+            workers_[worker_idx].thread =
+                std::thread(&WmWorkStealingExecutor::work, this, worker_idx);
+        }
+    }
+
+    /**
+     * @brief Dtor
+     * Waits for all the deques to be empty and joins all threads
+     */
+    ~WmWorkStealingExecutor() override final
+    {
+        {
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            stopped_.store(true);
+        }
+
+        park_cond_var_.notify_all();
+        for (size_t worker_idx = 0; worker_idx < workers_cnt_; ++worker_idx)
+            workers_[worker_idx].thread.join();
+    }
+
+    /**
+     * @brief Adds task to one of the deques
+     * @param func Task to be enqueued
+     * Is kept for compatibility: allocates record owning the function.
+     * @see WmAbstractExecutor::enqueue()
+     */
+    void enqueue(std::function<void()> func) override final
+    {
+        enqueue(new WmFunctionTask(std::move(func)));
+    }
+
+    /**
+     * @brief Adds task record to one of the deques without allocation
+     * @param task Task record to be enqueued
+     * Task with home is pushed to its home worker's deque.
+     * Otherwise being called from the worker thread pushes to the worker's
+     * own deque, else distributes tasks between deques in round-robin manner.
+     * @see WmAbstractExecutor::enqueue()
+     */
+    void enqueue(WmTask* task) override final
+    {
+        size_t worker_idx = (current_executor_ == this ?
+                current_worker_idx_ :
+                next_worker_idx_.fetch_add(1, std::memory_order_relaxed));
+
+        // counted before the push to never let pending_ underflow
+        pending_.fetch_add(1);
+        push(home_of(task, worker_idx), &task, 1);
+
+        wake(1);
+    }
+
+    /**
+     * @brief Adds batch of task records taking each deque lock once
+     * @param tasks Task records array
+     * @param count Number of records
+     * Tasks with homes are pushed to their home workers' deques one by one.
+     * Otherwise being called from the worker thread pushes to the worker's
+     * own deque, else splits the batch into contiguous chunks, one per worker.
+     * @see WmAbstractExecutor::enqueue_batch()
+     */
+    void enqueue_batch(WmTask* const* tasks, size_t count) override final
+    {
+        if (count == 0)
+            return;
+
+        pending_.fetch_add(count);
+
+        bool has_homes = std::any_of(tasks, tasks + count, [](WmTask* task) {
+                return task->home != WmTask::NNoHome;
+            });
+
+        if (has_homes)
+        {
+            size_t default_idx = (current_executor_ == this ?
+                    current_worker_idx_ : 0);
+
+            for (size_t idx = 0; idx < count; ++idx)
+                push(home_of(tasks[idx], default_idx), tasks + idx, 1);
+        }
+        else if (current_executor_ == this)
+        {
+            push(current_worker_idx_, tasks, count);
+        }
+        else
+        {
+            size_t chunk = (count + workers_cnt_ - 1) / workers_cnt_;
+            for (size_t worker_idx = 0, begin = 0; begin < count;
+                 ++worker_idx, begin += chunk)
+            {
+                push(worker_idx, tasks + begin, std::min(chunk, count - begin));
+            }
+        }
+
+        wake(count);
+    }
+
+    /**
+     * @brief Returns per-worker counters
+     * Queue depth is the maximum length of the worker's own deque.
+     * @see WmAbstractExecutor::metrics()
+     */
+    const WmExecutorMetrics& metrics() const noexcept override final
+    {
+        return metrics_;
+    }
+
+private:
+    /// Cache-line-aligned to avoid false sharing between the workers
+    struct alignas(64) Worker
+    {
+        std::mutex mutex{};
+        WmTask* head = nullptr; ///< the oldest task (stolen first)
+        WmTask* tail = nullptr; ///< the newest task (popped by owner)
+        size_t depth = 0; ///< number of tasks in the deque
+        std::thread thread{};
+
+        int cpu = -1; ///< pinned CPU (-1 if not pinned)
+        std::vector<size_t> victims{}; ///< steal order, the nearest first
+    };
+
+    /**
+     * @brief Returns topology distance between the CPUs
+     * Unpinned or unknown CPUs are treated as equally distant.
+     */
+    static int cpu_distance(const WmCpuTopology& topology, int lhs, int rhs)
+    {
+        const WmCpuTopology::Cpu* lhs_info = nullptr;
+        const WmCpuTopology::Cpu* rhs_info = nullptr;
+
+        for (const auto& info : topology.cpus)
+        {
+            if (info.cpu == lhs) lhs_info = &info;
+            if (info.cpu == rhs) rhs_info = &info;
+        }
+
+        if (!lhs_info || !rhs_info)
+            return 0;
+
+        return WmCpuTopology::distance(*lhs_info, *rhs_info);
+    }
+
+    /**
+     * @brief Returns the worker's index the task is to be pushed to
+     * @param task Task record
+     * @param default_idx Worker's index for the task without home
+     */
+    size_t home_of(const WmTask* task, size_t default_idx) const noexcept
+    {
+        return (task->home != WmTask::NNoHome ?
+                task->home : default_idx) % workers_cnt_;
+    }
+
+    /**
+     * @brief Appends the records to the tail of the worker's deque
+     */
+    void push(size_t worker_idx, WmTask* const* tasks, size_t count)
+    {
+        Worker& worker = workers_[worker_idx];
+        std::unique_lock<std::mutex> lock(worker.mutex);
+
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            WmTask* task = tasks[idx];
+
+            task->prev = worker.tail;
+            task->next = nullptr;
+
+            if (worker.tail)
+                worker.tail->next = task;
+            else
+                worker.head = task;
+
+            worker.tail = task;
+        }
+
+        worker.depth += count;
+        metrics_.worker(worker_idx).observe_depth(worker.depth);
+    }
+
+    /**
+     * @brief Wakes parked workers up for the count of new tasks
+     */
+    void wake(size_t count)
+    {
+        if (parked_.load() == 0)
+            return;
+
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        lock.unlock();
+
+        if (count == 1)
+            park_cond_var_.notify_one();
+        else
+            park_cond_var_.notify_all();
+    }
+
+    /**
+     * @brief Pops the newest task from the worker's own deque
+     * @return Task record or nullptr if there are no tasks
+     */
+    WmTask* try_pop(size_t worker_idx)
+    {
+        Worker& worker = workers_[worker_idx];
+        std::unique_lock<std::mutex> lock(worker.mutex);
+
+        WmTask* task = worker.tail;
+        if (!task)
+            return nullptr;
+
+        worker.tail = task->prev;
+        if (worker.tail)
+            worker.tail->next = nullptr;
+        else
+            worker.head = nullptr;
+
+        --worker.depth;
+
+        pending_.fetch_sub(1);
+
+        return task;
+    }
+
+    /**
+     * @brief Steals the oldest task from any other worker's deque
+     * Victims are tried in the order of growing topology distance.
+     * @return Task record or nullptr if there are no tasks
+     */
+    WmTask* try_steal(size_t worker_idx)
+    {
+        for (size_t victim_idx : workers_[worker_idx].victims)
+        {
+            Worker& victim = workers_[victim_idx];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+
+            if (!lock.owns_lock() || !victim.head)
+                continue;
+
+            WmTask* task = victim.head;
+
+            victim.head = task->next;
+            if (victim.head)
+                victim.head->prev = nullptr;
+            else
+                victim.tail = nullptr;
+
+            --victim.depth;
+
+            pending_.fetch_sub(1);
+
+            return task;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Worker thread main loop
+     * Exits when stopped and there are no more tasks to execute.
+     */
+    void work(size_t worker_idx)
+    {
+        current_executor_ = this;
+        current_worker_idx_ = worker_idx;
+
+        wm_pin_current_thread(workers_[worker_idx].cpu);
+        WM_TRACE_THREAD("stealing", worker_idx);
+
+        auto& counters = metrics_.worker(worker_idx);
+        WmExecutorMetrics::current() = &counters;
+
+        size_t spin_cnt = 0;
+        int64_t idle_start = WmExecutorMetrics::now();
+
+        while (true)
+        {
+            WmTask* task = try_pop(worker_idx);
+            if (!task)
+                task = try_steal(worker_idx);
+
+            if (task)
+            {
+                spin_cnt = 0;
+
+                int64_t start = WmExecutorMetrics::now();
+                counters.add_idle(idle_start, start);
+
+                task->execute();
+
+                idle_start = WmExecutorMetrics::now();
+                counters.add_task(start, idle_start);
+
+                continue;
+            }
+
+            if (pending_.load() > 0 || ++spin_cnt < NSpinCount)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            spin_cnt = 0;
+
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            if (stopped_.load() && pending_.load() == 0)
+                break;
+
+            parked_.fetch_add(1);
+            park_cond_var_.wait(lock, [this]() -> bool {
+                    return pending_.load() > 0 || stopped_.load();
+                });
+            parked_.fetch_sub(1);
+        }
+
+        current_executor_ = nullptr;
+        WmExecutorMetrics::current() = nullptr;
+    }
+
+    static inline thread_local
+        WmWorkStealingExecutor* current_executor_ = nullptr;
+    static inline thread_local
+        size_t current_worker_idx_ = 0;
+
+    size_t workers_cnt_ = 0;
+    std::unique_ptr<Worker[]> workers_;
+    WmExecutorMetrics metrics_;
+
+    std::atomic<size_t> next_worker_idx_{ 0 };
+    std::atomic<size_t> pending_{ 0 };
+    std::atomic<size_t> parked_{ 0 };
+    std::atomic<bool> stopped_{ false };
+
+    std::mutex park_mutex_{};
+    std::condition_variable park_cond_var_{};
+};
+
+/**
+ * @brief Test structure for WmWorkStealingExecutor
+ */
+struct WmWorkStealingExecutor::Test
+{
+    template<typename TStream>
+    static TStream& test_init(TStream& stream)
+    {
+        static constexpr size_t NDefaultConcurrency =
+            WmWorkStealingExecutor::NDefaultConcurrency;
+
+        WmWorkStealingExecutor executor(NDefaultConcurrency);
+
+        return stream;
+    }
+
+    template<typename TStream>
+    static TStream& test_run(TStream& stream)
+    {
+        static constexpr size_t NDefaultConcurrency =
+            WmWorkStealingExecutor::NDefaultConcurrency;
+
+        std::atomic<size_t> counter{ 0 };
+
+        {
+            WmWorkStealingExecutor executor(NDefaultConcurrency);
+
+            for (size_t idx = 0; idx < NDefaultConcurrency; ++idx)
+            {
+                executor.enqueue([&executor, &counter, inc = idx + 1]() {
+                        counter.fetch_add(inc);
+
+                        // nested task is pushed to the local deque
+                        executor.enqueue([&counter, inc]() {
+                                counter.fetch_add(inc);
+                            });
+                    });
+            }
+        }
+
+        stream << counter.load();
+
+        return stream;
+    }
+
+    template<typename TStream>
+    static TStream& test_batch(TStream& stream)
+    {
+        static constexpr size_t NDefaultConcurrency =
+            WmWorkStealingExecutor::NDefaultConcurrency;
+        static constexpr size_t NTaskCnt = 16;
+
+        struct CounterTask : public WmTask
+        {
+            std::atomic<size_t>* counter = nullptr;
+        };
+
+        std::atomic<size_t> counter{ 0 };
+        CounterTask tasks[NTaskCnt] = {};
+        WmTask* task_ptrs[NTaskCnt] = {};
+
+        for (size_t idx = 0; idx < NTaskCnt; ++idx)
+        {
+            tasks[idx].func = [](WmTask* task) {
+                    static_cast<CounterTask*>(task)->counter->fetch_add(1);
+                };
+            tasks[idx].counter = &counter;
+            task_ptrs[idx] = &tasks[idx];
+        }
+
+        // the same executor and records are reused for several batches
+        WmWorkStealingExecutor executor(NDefaultConcurrency);
+        WmCompletion completion;
+
+        for (size_t batch_idx = 0; batch_idx < NDefaultConcurrency; ++batch_idx)
+        {
+            executor.submit(task_ptrs, NTaskCnt, completion);
+            completion.wait();
+
+            stream << counter.load() << ' ';
+        }
+
+        return stream;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_WORK_STEALING_EXECUTOR_H_
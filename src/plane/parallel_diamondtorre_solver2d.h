@@ -0,0 +1,221 @@
+#ifndef WAVE_MODEL_PARALLEL_DIAMONDTORRE_SOLVER2D_H_
+#define WAVE_MODEL_PARALLEL_DIAMONDTORRE_SOLVER2D_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include "logging/macro.h"
+
+#include "parallel/abstract_executor.h"
+#include "parallel/task.h"
+#include "parallel/completion.h"
+#include "parallel/executor_metrics.h"
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include <cstdint>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Solver executing DiamondTorre lines in pipelined manner
+ * @tparam TS Stencil type
+ * @tparam TT Tiling type (must be WmGeneralDiamondTorreTiling2D)
+ * @tparam TL Layer template
+ * @tparam NRX Domain rank by X
+ * @tparam NRY Domain rank by Y
+ *
+ * Each line of torres is a task, lines run concurrently on the workers.
+ * Line publishes the number of its finished poles in its progress flag
+ * and starts the pole only when the previous line is NPoleLag poles ahead,
+ * so the neighbouring lines synchronize point-to-point without barriers.
+ * Line enqueues the next one when it starts, hence every awaited line
+ * is already running and any executor (even sequential) can't deadlock.
+ */
+template<typename TS, typename TT,
+         template<typename, size_t, size_t> typename TL,
+         size_t NRX, size_t NRY>
+class WmParallelDiamondTorreSolver2D
+{
+public:
+    static constexpr size_t NRankX = NRX;
+    static constexpr size_t NRankY = NRY;
+
+    using TStencil = TS;
+    using TTiling = TT;
+    using TLayer = TL<typename TStencil::TData, NRankX, NRankY>;
+    using TLine = typename TTiling::Line;
+
+    static constexpr size_t NTileRank = TTiling::NTileRank;
+    static constexpr size_t NSizeX = TLayer::NDomainLengthX;
+    static constexpr size_t NSizeY = TLayer::NDomainLengthY;
+    static constexpr size_t NMod = TStencil::NMod;
+
+    /// Number of poles the previous line must be ahead of the current one
+    static constexpr int64_t NPoleLag = 2;
+
+    static_assert(NMod > 0, "NMod must be positive");
+
+    /**
+     * @brief Ctor from domain length and time delta
+     * @param length Domain side length
+     * @param dtime Time discretization delta
+     */
+    WmParallelDiamondTorreSolver2D(double length, double dtime):
+        length_(length),
+        stencil_(length_ / NSizeY, dtime),
+        layers_arr_{}
+    {
+        TTiling::template for_each_line<NRankX, TLayer>(
+            [this](const TLine& line) { lines_.push_back(line); });
+
+        progress_ = std::make_unique<Progress[]>(lines_.size());
+        tasks_ = std::make_unique<LineTask[]>(lines_.size());
+
+        for (size_t line_idx = 0; line_idx < lines_.size(); ++line_idx)
+        {
+            tasks_[line_idx].func = &WmParallelDiamondTorreSolver2D::execute;
+            tasks_[line_idx].solver = this;
+            tasks_[line_idx].line_idx = line_idx;
+        }
+    }
+
+    /**
+     * @brief Ctor from domain length, time delta and initial state function
+     * @tparam TInitFunc Initial state function type
+     * @param length Domain length
+     * @param dtime Time delta
+     * @param init_func Initial state function
+     */
+    template<typename TInitFunc>
+    WmParallelDiamondTorreSolver2D(double length, double dtime,
+                                   TInitFunc&& init_func):
+        WmParallelDiamondTorreSolver2D(length, dtime)
+    {
+        layers_arr_[NMod - 1]
+            .init(length_, std::forward<TInitFunc>(init_func));
+    }
+
+    WmParallelDiamondTorreSolver2D
+        (const WmParallelDiamondTorreSolver2D&) = delete;
+    WmParallelDiamondTorreSolver2D& operator =
+        (const WmParallelDiamondTorreSolver2D&) = delete;
+
+    /**
+     * @brief Returns current top layer
+     * @return Current top layer
+     */
+    const TLayer& layer() const noexcept
+    {
+        return layers_arr_[NMod - 1];
+    }
+
+    /**
+     * @brief Executes proc_cnt calculation steps
+     * @param executor Object to execute lines
+     * @param proc_cnt Number of steps to do
+     */
+    void advance(WmAbstractExecutor& executor, size_t proc_cnt)
+    {
+        static constexpr size_t NShift = (1u << NTileRank) % NMod;
+
+        executor_ = &executor;
+
+        size_t proc_idx = 0;
+        for (; proc_idx < proc_cnt; proc_idx += (1u << NTileRank))
+        {
+            for (size_t line_idx = 0; line_idx < lines_.size(); ++line_idx)
+            {
+                progress_[line_idx].poles.store(0, std::memory_order_relaxed);
+                tasks_[line_idx].completion = &completion_;
+            }
+
+            completion_.add(lines_.size());
+            executor.enqueue(&tasks_[0]);
+            completion_.wait();
+
+            // rotate right to emulate dynamic programming with limited memory
+            std::rotate(std::rbegin(layers_arr_),
+                        std::rbegin(layers_arr_) + NShift,
+                        std::rend(layers_arr_));
+        }
+    }
+
+private:
+    /// Cache-line-aligned progress flag of the line
+    struct alignas(64) Progress
+    {
+        std::atomic<int64_t> poles{ 0 }; ///< number of finished poles
+    };
+
+    /// Preallocated task record of the line
+    struct LineTask : public WmTask
+    {
+        WmParallelDiamondTorreSolver2D* solver = nullptr;
+        size_t line_idx = 0;
+    };
+
+    /**
+     * @brief Processes the line synchronizing with the previous one
+     */
+    static void execute(WmTask* task)
+    {
+        auto* line_task = static_cast<LineTask*>(task);
+        WmParallelDiamondTorreSolver2D* self = line_task->solver;
+        size_t line_idx = line_task->line_idx;
+
+        const TLine& line = self->lines_[line_idx];
+        int64_t pole_cnt = TTiling::template pole_count<TLayer>(line.type);
+
+        auto sync = [self, line_idx, pole_cnt](int64_t pole_idx) {
+                self->progress_[line_idx].poles
+                    .store(pole_idx, std::memory_order_release);
+
+                if (pole_idx == pole_cnt || line_idx == 0)
+                    return;
+
+                const TLine& prev_line = self->lines_[line_idx - 1];
+                int64_t required = std::min(pole_idx + NPoleLag,
+                        TTiling::template pole_count<TLayer>(prev_line.type));
+
+                if (self->progress_[line_idx - 1].poles
+                        .load(std::memory_order_acquire) >= required)
+                    return;
+
+                WmBlockedScope blocked;
+                while (self->progress_[line_idx - 1].poles
+                        .load(std::memory_order_acquire) < required)
+                    std::this_thread::yield();
+            };
+
+        // the next line is started as soon as this one is running
+        if (line_idx + 1 < self->lines_.size())
+            self->executor_->enqueue(&self->tasks_[line_idx + 1]);
+
+        TTiling::template dispatch_line<NRankX>(
+                line, self->stencil_, self->layers_arr_, sync);
+    }
+
+    double length_;
+    TStencil stencil_;
+    TLayer layers_arr_[NMod];
+
+    std::vector<TLine> lines_;
+    std::unique_ptr<Progress[]> progress_;
+    std::unique_ptr<LineTask[]> tasks_;
+
+    WmAbstractExecutor* executor_ = nullptr;
+    WmCompletion completion_{};
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_PARALLEL_DIAMONDTORRE_SOLVER2D_H_
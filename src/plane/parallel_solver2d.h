@@ -8,13 +8,21 @@
  */
 
 #include "logging/macro.h"
+#include "logging/trace.h"
 
 #include "parallel/abstract_executor.h"
 #include "parallel/grid_graph.h"
-#include "parallel/counting_semaphore.h"
+#include "parallel/dataflow_scheduler.h"
+#include "parallel/node_splitter.h"
+#include "parallel/coroutine_scheduler.h"
+#include "parallel/numa_partition.h"
+#include "parallel/static_scheduler.h"
+#include "parallel/graph_analyzer.h"
 
 #include <vector>
+#include <memory>
 #include <algorithm>
+#include <chrono>
 
 #include <cstdint>
 
@@ -46,6 +54,9 @@ public:
     static constexpr size_t NSizeY = TLayer::NDomainLengthY;
     static constexpr size_t NMod = TStencil::NMod;
 
+    /// Number of windows processed by advance_pipelined() without barrier
+    static constexpr size_t NPipelineDepth = 4;
+
     static_assert(NMod > 0, "NMod must be positive");
 
 /*
@@ -61,7 +72,10 @@ public:
         length_(length),
         stencil_(length_ / NSizeY, dtime),
         grid_(layers_arr_, stencil_),
-        grid_graph_(grid_.build_graph())
+        grid_graph_(grid_.build_graph()),
+        scheduler_(grid_graph_),
+        splitter_(scheduler_),
+        window_body_{ this }
     {}
 
     /**
@@ -79,6 +93,115 @@ public:
             .init(length_, std::forward<TInitFunc>(init_func));
     }
 
+    WmParallelSolver2D             (const WmParallelSolver2D&) = delete;
+    WmParallelSolver2D& operator = (const WmParallelSolver2D&) = delete;
+
+    /**
+     * @brief Restarts the solver from the new initial state
+     * Reuses layers storage, grid and schedules, so the solver
+     * can be recycled between independent runs of the same domain.
+     * @tparam TInitFunc Initial state function type
+     * @param init_func Initial state function
+     */
+    template<typename TInitFunc>
+    void reset(TInitFunc&& init_func)
+    {
+        using TData = typename TLayer::TData;
+
+        for (size_t layer_idx = 0; layer_idx + 1 < NMod; ++layer_idx)
+            layers_arr_[layer_idx].init(length_, 
+                    [](double, double) { return TData{}; });
+
+        layers_arr_[NMod - 1]
+            .init(length_, std::forward<TInitFunc>(init_func));
+
+        window_idx_ = 0;
+    }
+
+    /**
+     * @brief Initializes layers in NUMA-aware manner
+     * Layers storage is reallocated untouched and each strip of rows
+     * is first touched and initialized by the worker owning it,
+     * then grid nodes are bound to the owners of their cell rows.
+     * Makes sense for the executors honoring task homes,
+     * whose workers are pinned with the partition's affinity policy.
+     * @tparam TInitFunc Initial state function type
+     * @param executor Object to initialize strips and execute grid nodes
+     * @param partition Rows partition between the executor workers
+     * @param init_func Initial state function (called concurrently)
+     */
+    template<typename TInitFunc>
+    void init(WmAbstractExecutor& executor,
+              const WmNumaPartition& partition, TInitFunc&& init_func)
+    {
+        using TData = typename TLayer::TData;
+
+        for (TLayer& layer : layers_arr_)
+            layer.reset_untouched();
+
+        std::vector<WmTask*> tasks;
+        for (size_t strip = 0; strip < partition.strips_count(); ++strip)
+        {
+            int64_t y_begin = partition.strip_begin(strip, NSizeY);
+            int64_t y_end = partition.strip_begin(strip + 1, NSizeY);
+
+            tasks.push_back(new WmFunctionTask(
+                [this, &init_func, y_begin, y_end]() {
+                    for (size_t layer_idx = 0; layer_idx < NMod; ++layer_idx)
+                    {
+                        if (layer_idx == NMod - 1)
+                        {
+                            layers_arr_[layer_idx].init_rows(
+                                    length_, init_func, y_begin, y_end);
+                        }
+                        else
+                        {
+                            layers_arr_[layer_idx].init_rows(length_,
+                                    [](double, double) { return TData{}; },
+                                    y_begin, y_end);
+                        }
+                    }
+                }));
+            tasks.back()->home = partition.strip_worker(strip);
+        }
+
+        WmCompletion completion;
+        executor.submit(tasks.data(), tasks.size(), completion);
+        completion.wait();
+
+        // node is bound to the owner of its cell's first row
+        std::vector<size_t> homes(TGrid::NNodes);
+        for (size_t idx = 0; idx < TGrid::NNodes; ++idx)
+        {
+            size_t cell_y = (idx % (TGrid::NCellCountX * TGrid::NCellCountY)) /
+                TGrid::NCellCountX;
+            size_t row_idx = std::min(cell_y * TGrid::NCellSide, NSizeY - 1);
+
+            homes[idx] = partition.row_worker(row_idx, NSizeY);
+        }
+
+        scheduler_.set_homes(homes);
+        if (pipeline_scheduler_)
+            pipeline_scheduler_->set_homes(homes);
+#if defined(WM_HAS_COROUTINES)
+        if (coroutine_scheduler_)
+            coroutine_scheduler_->set_homes(homes);
+#endif // defined(WM_HAS_COROUTINES)
+
+        node_homes_ = std::move(homes);
+    }
+
+    /**
+     * @brief Enables splitting of the nodes into their children
+     * Applies to advance() and start_window(): node is split when
+     * there are fewer ready nodes than workers (enabled by default).
+     * @param enabled Whether to split the nodes
+     */
+    void set_splitting(bool enabled) noexcept
+    {
+        splitting_ = enabled;
+    }
+
     /**
      * @brief Returns current top layer
      * @return Current top layer
@@ -95,30 +218,12 @@ public:
      */
     void advance(WmAbstractExecutor& executor, size_t proc_cnt)
     {
-        static constexpr size_t NShift = (1u << NTileRank) % NMod;
-
         size_t proc_idx = 0;
         for (; proc_idx < proc_cnt; proc_idx += (1u << NTileRank))
         {
-            // make computations in grid order
-            for (size_t idx : grid_graph_.order)
-            {
-                executor.enqueue([this, idx]() {
-                        for (size_t affect : grid_graph_.graph[idx])
-                            semaphores_[affect].acquire();
-
-                        grid_.access_node(idx)->execute();
-                        semaphores_[idx].release();
-
-                        for (size_t affect : grid_graph_.graph[idx])
-                            semaphores_[affect].release();
-                    });
-            }
-
-            // rotate right to emulate dynamic programming with limited memory
-            std::rotate(std::rbegin(layers_arr_), 
-                        std::rbegin(layers_arr_) + NShift, 
-                        std::rend(layers_arr_));
+            // each node is enqueued when its last dependency is done
+            scheduler_.run(executor, window_body_);
+            finish_window();
         }
 /*
         // rotate left to put result in TStencil::NDepth's position
@@ -129,12 +234,233 @@ public:
 */
     }
 
+    /**
+     * @brief Starts processing of the next window without blocking
+     * Allows to interleave windows of many solvers on the same executor.
+     * Window must be followed by finish_window() once completion is ready.
+     * @param executor Object to execute grid nodes
+     * @param completion Handle to wait for the window to be done
+     */
+    void start_window(WmAbstractExecutor& executor, WmCompletion& completion)
+    {
+        scheduler_.start(executor, window_body_, completion);
+    }
+
+    /**
+     * @brief Finishes the processed window
+     * Rotates layers, so the window's result becomes the top layer.
+     */
+    void finish_window()
+    {
+        static constexpr size_t NShift = (1u << NTileRank) % NMod;
+
+        ++window_idx_;
+
+        // rotate right to emulate dynamic programming with limited memory
+        std::rotate(std::rbegin(layers_arr_), 
+                    std::rbegin(layers_arr_) + NShift, 
+                    std::rend(layers_arr_));
+    }
+
+    /**
+     * @brief Executes proc_cnt calculation steps pipelining the windows
+     * Windows are processed in batches of NPipelineDepth ones without
+     * barriers inside the batch: node of the next window starts as soon as
+     * its own dependencies in the previous window are done.
+     * Layers rotation is emulated per node via its first layer index.
+     * @param executor Object to execute grid nodes
+     * @param proc_cnt Number of steps to do
+     */
+    void advance_pipelined(WmAbstractExecutor& executor, size_t proc_cnt)
+    {
+        static constexpr size_t NShift = (1u << NTileRank) % NMod;
+        static constexpr size_t NWindowSteps = (1u << NTileRank);
+
+        if (!pipeline_scheduler_)
+        {
+            pipeline_scheduler_ = std::make_unique<WmDataflowScheduler>(
+                    grid_.build_pipeline_graph(NPipelineDepth));
+            pipeline_scheduler_->set_homes(node_homes_);
+        }
+
+        size_t window_cnt = (proc_cnt + NWindowSteps - 1) / NWindowSteps;
+        for (; window_cnt >= NPipelineDepth; window_cnt -= NPipelineDepth)
+        {
+            pipeline_scheduler_->run(executor, [this](size_t idx) {
+                    size_t window_idx = idx / TGrid::NNodes;
+                    size_t layer_idx = 
+                        (NMod - (window_idx * NShift) % NMod) % NMod;
+
+                    auto* node = grid_.access_node(idx % TGrid::NNodes);
+                    WM_TRACE_NODE(idx % TGrid::NNodes, window_idx_ + window_idx,
+                                  node->type_x(), node->type_y());
+
+                    node->execute(layer_idx);
+                });
+
+            window_idx_ += NPipelineDepth;
+
+            // the whole batch rotation at once
+            std::rotate(std::rbegin(layers_arr_), 
+                        std::rbegin(layers_arr_) + 
+                            (NPipelineDepth * NShift) % NMod, 
+                        std::rend(layers_arr_));
+        }
+
+        // the rest is processed window by window
+        advance(executor, window_cnt * NWindowSteps);
+    }
+
+#if defined(WM_HAS_COROUTINES)
+    /**
+     * @brief Executes proc_cnt calculation steps by the node coroutines
+     * Nodes await their predecessors without blocking the workers
+     * and are resumed by the worker completing the last of them.
+     * Is available only when compiled as C++20.
+     * @param executor Object to resume grid nodes
+     * @param proc_cnt Number of steps to do
+     */
+    void advance_coroutine(WmAbstractExecutor& executor, size_t proc_cnt)
+    {
+        if (!coroutine_scheduler_)
+        {
+            coroutine_scheduler_ = 
+                std::make_unique<WmCoroutineScheduler>(grid_graph_);
+            coroutine_scheduler_->set_homes(node_homes_);
+        }
+
+        for (size_t proc_idx = 0; proc_idx < proc_cnt;
+             proc_idx += (1u << NTileRank))
+        {
+            coroutine_scheduler_->run(executor, [this](size_t idx) {
+                    auto* node = grid_.access_node(idx);
+                    WM_TRACE_NODE(idx, window_idx_,
+                                  node->type_x(), node->type_y());
+
+                    node->execute();
+                });
+
+            finish_window();
+        }
+    }
+
+#endif // defined(WM_HAS_COROUTINES)
+
+    /**
+     * @brief Executes proc_cnt calculation steps by the static schedule
+     * Nodes are distributed between threads_cnt threads once,
+     * the schedule is rebuilt only if threads count is changed.
+     * @param threads_cnt Number of threads (including the calling one)
+     * @param proc_cnt Number of steps to do
+     */
+    void advance_static(size_t threads_cnt, size_t proc_cnt)
+    {
+        static constexpr size_t NShift = (1u << NTileRank) % NMod;
+
+        if (!static_scheduler_ ||
+            static_scheduler_->threads_count() != threads_cnt)
+        {
+            static_scheduler_.reset();
+            static_scheduler_ = std::make_unique<WmStaticScheduler>(
+                    grid_graph_, threads_cnt);
+        }
+
+        for (size_t proc_idx = 0; proc_idx < proc_cnt;
+             proc_idx += (1u << NTileRank))
+        {
+            static_scheduler_->run([this](size_t idx) {
+                    auto* node = grid_.access_node(idx);
+                    WM_TRACE_NODE(idx, window_idx_,
+                                  node->type_x(), node->type_y());
+
+                    node->execute();
+                });
+
+            ++window_idx_;
+
+            // rotate right to emulate dynamic programming with limited memory
+            std::rotate(std::rbegin(layers_arr_), 
+                        std::rbegin(layers_arr_) + NShift, 
+                        std::rend(layers_arr_));
+        }
+    }
+
+    /**
+     * @brief Builds analyzer of the grid graph
+     * Node costs are either modeled by the numbers of stencil applications
+     * or measured in seconds by executing one window sequentially
+     * (the latter advances the solver by one window).
+     * @param measured Whether to measure costs instead of modeling
+     * @return Analyzer of the grid graph
+     */
+    WmGraphAnalyzer analyze(bool measured = false)
+    {
+        using TClock = std::chrono::steady_clock;
+
+        static constexpr size_t NShift = (1u << NTileRank) % NMod;
+
+        if (!measured)
+            return WmGraphAnalyzer(grid_graph_, grid_.model_costs());
+
+        std::vector<double> costs(TGrid::NNodes, 0.0);
+        for (size_t idx : grid_graph_.order)
+        {
+            auto* node = grid_.access_node(idx);
+            WM_TRACE_NODE(idx, window_idx_, node->type_x(), node->type_y());
+
+            auto start = TClock::now();
+            node->execute();
+
+            costs[idx] = std::chrono::duration<double>(
+                    TClock::now() - start).count();
+        }
+
+        std::rotate(std::rbegin(layers_arr_), 
+                    std::rbegin(layers_arr_) + NShift, 
+                    std::rend(layers_arr_));
+
+        ++window_idx_;
+
+        return WmGraphAnalyzer(grid_graph_, costs);
+    }
+
 private:
+    /// Node function of the window (outlives the asynchronous runs)
+    struct WindowBody
+    {
+        WmParallelSolver2D* self;
+
+        void operator () (size_t idx) const
+        {
+            auto* node = self->grid_.access_node(idx);
+            WM_TRACE_NODE(idx, self->window_idx_,
+                          node->type_x(), node->type_y());
+
+            if constexpr (NCellRank > 0)
+            {
+                if (self->splitting_ && self->splitter_.split(node, idx, 0))
+                    return;
+            }
+
+            node->execute();
+        }
+    };
+
     double length_ = 0.0;
     TStencil stencil_;
     TGrid grid_;
     WmGridGraph grid_graph_;
-    WmCountingSemaphore<1> semaphores_[TGrid::NNodes];
+    WmDataflowScheduler scheduler_;
+    WmNodeSplitter<typename TGrid::TNode> splitter_;
+    std::unique_ptr<WmDataflowScheduler> pipeline_scheduler_;
+    std::unique_ptr<WmStaticScheduler> static_scheduler_;
+#if defined(WM_HAS_COROUTINES)
+    std::unique_ptr<WmCoroutineScheduler> coroutine_scheduler_;
+#endif // defined(WM_HAS_COROUTINES)
+    WindowBody window_body_;
+    std::vector<size_t> node_homes_;
+    size_t window_idx_ = 0; ///< index of the next window to process
+    bool splitting_ = true;
     TLayer layers_arr_[NMod];
 };
 
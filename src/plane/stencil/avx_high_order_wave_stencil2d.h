@@ -0,0 +1,242 @@
+#ifndef WAVE_MODEL_STENCIL_AVX_HIGH_ORDER_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_AVX_HIGH_ORDER_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
+#include "stencil/high_order_wave_stencil2d.h"
+
+#include <utility>
+
+#include <cstdint>
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace wave_model {
+
+/**
+ * @brief 4x4 block of cells, each row is processed by one AVX register
+ * Is laid out as WmPackedBasicWaveData2D<double, 4, 4>.
+ */
+struct alignas(32) WmAvxHighOrderWaveData2D
+{
+    static constexpr double FFactor = 1.0;
+    static constexpr size_t NCellsX = 4;
+    static constexpr size_t NCellsY = 4;
+
+    double intencity[NCellsX * NCellsY];
+};
+
+template<typename TStream>
+TStream& operator << (TStream& stream,
+                      const WmAvxHighOrderWaveData2D& wave_data)
+{
+    const double* buf = wave_data.intencity;
+    for (size_t idx = 0; idx < 16u; ++idx)
+        stream << buf[idx] << (idx + 1 < 16u ? " " : "");
+
+    return stream;
+}
+
+/**
+ * @brief Wave stencil of the order 2 * NRadius over 4x4 blocks with AVX
+ * Rows of the neighbour blocks are shifted into the block row with
+ * in-lane shuffles, so any radius up to 4 takes the same loads.
+ * Is bitwise equal to WmHighOrderWaveStencil2D<NRadius, 4, 4>.
+ * @tparam NRadius Stencil radius from 1 to 4
+ */
+template<size_t NRadius>
+class WmAvxHighOrderWaveStencil2D
+{
+public:
+    static_assert(NRadius >= 1 && NRadius <= 4, "radius must be 1..4");
+
+    using TData = WmAvxHighOrderWaveData2D;
+    using TCoeffs = WmHighOrderCoeffs<NRadius>;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmAvxHighOrderWaveStencil2D(double dspace, double dtime)
+    {
+        double inv_dspace = 1.0 / (dspace / TData::NCellsY);
+        double courant = TData::FFactor * dtime * inv_dspace;
+        courant2_ = courant * courant;
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    WM_TARGET_AVX void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = {
+            NLayerIdx % NMod,
+            (NLayerIdx + NMod - 2) % NMod,
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        static constexpr int64_t NRows = TData::NCellsY;
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0)
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0)
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+
+        // rows of the top, the center and the bottom blocks
+        __m256d rows[3 * NRows];
+        for (int64_t row = 0; row < NRows; ++row)
+        {
+            __m256d center =
+                _mm256_load_pd(prev[idx].intencity + 4 * row);
+
+            rows[NRows + row] = center;
+            rows[row] = _mm256_load_pd(prev[idx + sub_y].intencity + 4 * row);
+            rows[2 * NRows + row] =
+                _mm256_load_pd(prev[idx + add_y].intencity + 4 * row);
+        }
+
+        // cells out of the domain take the nearest side values
+        for (int64_t row = 0; row < NRows; ++row)
+        {
+            if constexpr (NYSide < 0)
+                rows[row] = rows[NRows];
+            if constexpr (NYSide > 0)
+                rows[2 * NRows + row] = rows[2 * NRows - 1];
+        }
+
+        __m256d courant2 = _mm256_set1_pd(courant2_);
+        __m256d results[NRows];
+
+        for (int64_t row = 0; row < NRows; ++row)
+        {
+            static constexpr int64_t NR = NRadius;
+
+            __m256d center = rows[NRows + row];
+            __m256d left =
+                _mm256_load_pd(prev[idx + sub_x].intencity + 4 * row);
+            __m256d right =
+                _mm256_load_pd(prev[idx + add_x].intencity + 4 * row);
+
+            if constexpr (NXSide < 0)
+            {
+                left = _mm256_permute_pd(center, 0b0000);
+                left = _mm256_permute2f128_pd(left, left, 0x00);
+            }
+            if constexpr (NXSide > 0)
+            {
+                right = _mm256_permute_pd(center, 0b1111);
+                right = _mm256_permute2f128_pd(right, right, 0x11);
+            }
+
+            __m256d pairs_x[NRadius + 1];
+            fill_pairs(std::make_index_sequence<NRadius>{},
+                       left, center, right, pairs_x);
+
+            __m256d lap_y = _mm256_mul_pd(
+                    _mm256_set1_pd(TCoeffs::NCoeffs[NR]),
+                    _mm256_add_pd(rows[NRows + row + NR],
+                                  rows[NRows + row - NR]));
+            __m256d lap_x = _mm256_mul_pd(
+                    _mm256_set1_pd(TCoeffs::NCoeffs[NR]), pairs_x[NR]);
+
+            for (int64_t dist = NR - 1; dist > 0; --dist)
+            {
+                __m256d coeff = _mm256_set1_pd(TCoeffs::NCoeffs[dist]);
+
+                lap_y = _mm256_add_pd(lap_y, _mm256_mul_pd(
+                        coeff,
+                        _mm256_add_pd(rows[NRows + row + dist],
+                                      rows[NRows + row - dist])));
+                lap_x = _mm256_add_pd(lap_x,
+                                      _mm256_mul_pd(coeff, pairs_x[dist]));
+            }
+
+            __m256d center0 =
+                _mm256_mul_pd(_mm256_set1_pd(TCoeffs::NCoeffs[0]), center);
+
+            lap_y = _mm256_add_pd(lap_y, center0);
+            lap_x = _mm256_add_pd(lap_x, center0);
+
+            results[row] = _mm256_sub_pd(
+                    _mm256_mul_pd(_mm256_add_pd(lap_y, lap_x), courant2),
+                    _mm256_load_pd(layers[AIdx[2]][idx].intencity + 4 * row));
+        }
+
+        // the target block is the center one
+        for (int64_t row = 0; row < NRows; ++row)
+            _mm256_store_pd(layers[AIdx[0]][idx].intencity + 4 * row,
+                            results[row]);
+    }
+
+private:
+    /**
+     * @brief Returns the row values at the distance NShift along x
+     */
+    template<int NShift>
+    WM_TARGET_AVX static __m256d shifted(__m256d left, __m256d center,
+                                         __m256d right)
+    {
+        // l0 l1 l2 l3 | c0 c1 c2 c3 | r0 r1 r2 r3
+        if constexpr (NShift == -4)
+            return left;
+        else if constexpr (NShift == 4)
+            return right;
+        else if constexpr (NShift == -2) // l2 l3 c0 c1
+            return _mm256_permute2f128_pd(left, center, 0x21);
+        else if constexpr (NShift == 2) // c2 c3 r0 r1
+            return _mm256_permute2f128_pd(center, right, 0x21);
+        else if constexpr (NShift == -3) // l1 l2 l3 c0
+            return _mm256_shuffle_pd(
+                    left, shifted<-2>(left, center, right), 0b0101);
+        else if constexpr (NShift == -1) // l3 c0 c1 c2
+            return _mm256_shuffle_pd(
+                    shifted<-2>(left, center, right), center, 0b0101);
+        else if constexpr (NShift == 1) // c1 c2 c3 r0
+            return _mm256_shuffle_pd(
+                    center, shifted<2>(left, center, right), 0b0101);
+        else if constexpr (NShift == 3) // c3 r0 r1 r2
+            return _mm256_shuffle_pd(
+                    shifted<2>(left, center, right), right, 0b0101);
+        else
+            return center;
+    }
+
+    /**
+     * @brief Sums the row values at the distances +-(NDists + 1) along x
+     */
+    template<size_t... NDists>
+    WM_TARGET_AVX static void fill_pairs(std::index_sequence<NDists...>,
+                                         __m256d left, __m256d center,
+                                         __m256d right, __m256d* pairs)
+    {
+        ((pairs[NDists + 1] = _mm256_add_pd(
+                shifted<static_cast<int>(NDists) + 1>(left, center, right),
+                shifted<-static_cast<int>(NDists) - 1>(left, center, right))
+         ), ...);
+    }
+
+    double courant2_ = 0.0;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_AVX_HIGH_ORDER_WAVE_STENCIL2D_H_
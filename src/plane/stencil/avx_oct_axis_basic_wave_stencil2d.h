@@ -0,0 +1,161 @@
+#ifndef WAVE_MODEL_STENCIL_AVX_OCT_AXIS_BASIC_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_AVX_OCT_AXIS_BASIC_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace wave_model {
+
+/**
+ * @brief Eight single-precision cells of the row in one AVX register
+ */
+struct alignas(32) WmAvxOctAxisBasicWaveData2D
+{
+    static constexpr float FFactor = 1.0f;
+    static constexpr size_t NCellsX = 8;
+    static constexpr size_t NCellsY = 1;
+
+    float intencity[NCellsX * NCellsY];
+};
+
+template<typename TStream>
+TStream& operator << (TStream& stream, 
+                      const WmAvxOctAxisBasicWaveData2D& wave_data)
+{
+    const float* buf = wave_data.intencity;
+    for (size_t idx = 0; idx < 8u; ++idx)
+        stream << buf[idx] << (idx + 1 < 8u ? " " : "");
+
+    return stream;
+}
+
+/**
+ * @brief Single-precision stencil over 1x8 rows of cells
+ * Doubles the SIMD width and halves the memory traffic of
+ * WmAvxAxisBasicWaveStencil2D.
+ * The outer lanes of the domain sides take their own values.
+ * Is bitwise equal to WmPackedBasicWaveStencil2D<float, ...> of
+ * the same block shape, which is its portable reference.
+ */
+class WmAvxOctAxisBasicWaveStencil2D
+{
+public:
+    using TData = WmAvxOctAxisBasicWaveData2D;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmAvxOctAxisBasicWaveStencil2D(double dspace, double dtime)
+    {
+        double courant = TData::FFactor * dtime / (dspace / TData::NCellsY);
+        courant2_ = static_cast<float>(courant * courant);
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    WM_TARGET_AVX void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = { 
+            NLayerIdx % NMod, 
+            (NLayerIdx + NMod - 2) % NMod, 
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0) 
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0) 
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+
+        __m256 center = _mm256_load_ps(prev[idx].intencity);
+
+        // abcdefgh (left) ABCDEFGH -> efgh|ABCD -> hABC|DEFG
+        __m256 sub_x_intencity = _mm256_blend_ps(
+                _mm256_permute_ps(center, _MM_SHUFFLE(2, 1, 0, 3)),
+                _mm256_permute_ps(
+                    _mm256_permute2f128_ps(
+                        _mm256_load_ps(prev[idx + sub_x].intencity), center,
+                        0b0010'0001
+                        ),
+                    _MM_SHUFFLE(2, 1, 0, 3)
+                    ),
+                0b0001'0001
+                );
+
+        // ABCDEFGH abcdefgh (right) -> EFGH|abcd -> BCDE|FGHa
+        __m256 add_x_intencity = _mm256_blend_ps(
+                _mm256_permute_ps(center, _MM_SHUFFLE(0, 3, 2, 1)),
+                _mm256_permute_ps(
+                    _mm256_permute2f128_ps(
+                        center, _mm256_load_ps(prev[idx + add_x].intencity),
+                        0b0010'0001
+                        ),
+                    _MM_SHUFFLE(0, 3, 2, 1)
+                    ),
+                0b1000'1000
+                );
+
+        if constexpr (NXSide < 0)
+            sub_x_intencity = _mm256_blend_ps(sub_x_intencity, center, 
+                                              0b0000'0001);
+        if constexpr (NXSide > 0)
+            add_x_intencity = _mm256_blend_ps(add_x_intencity, center, 
+                                              0b1000'0000);
+
+        __m256 center2 = _mm256_mul_ps(_mm256_set1_ps(2.0f), center);
+
+        _mm256_store_ps(
+            layers[AIdx[0]][idx].intencity,
+            _mm256_sub_ps(
+                _mm256_mul_ps(
+                    _mm256_add_ps(
+                        _mm256_sub_ps(
+                            _mm256_add_ps(
+                                _mm256_load_ps(prev[idx + add_y].intencity),
+                                _mm256_load_ps(prev[idx + sub_y].intencity)
+                                ),
+                            center2
+                            ),
+                        _mm256_sub_ps(
+                            _mm256_add_ps(add_x_intencity, sub_x_intencity),
+                            center2
+                            )
+                        ),
+                    _mm256_set1_ps(courant2_)
+                    ),
+                _mm256_load_ps(layers[AIdx[2]][idx].intencity)
+                )
+            );
+    }
+
+private:
+    float courant2_ = 0.0f;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_AVX_OCT_AXIS_BASIC_WAVE_STENCIL2D_H_
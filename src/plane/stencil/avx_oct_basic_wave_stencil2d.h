@@ -0,0 +1,194 @@
+#ifndef WAVE_MODEL_STENCIL_AVX_OCT_BASIC_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_AVX_OCT_BASIC_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace wave_model {
+
+/**
+ * @brief Eight single-precision cells processed by one AVX register
+ * Cells form the 2x4 block: lanes 0-3 are the upper row, 4-7 the lower.
+ */
+struct alignas(32) WmAvxOctBasicWaveData2D
+{
+    static constexpr float FFactor = 1.0f;
+    static constexpr size_t NCellsX = 4;
+    static constexpr size_t NCellsY = 2;
+
+    float intencity[NCellsX * NCellsY];
+};
+
+template<typename TStream>
+TStream& operator << (TStream& stream, 
+                      const WmAvxOctBasicWaveData2D& wave_data)
+{
+    const float* buf = wave_data.intencity;
+    for (size_t idx = 0; idx < 8u; ++idx)
+        stream << buf[idx] << (idx + 1 < 8u ? " " : "");
+
+    return stream;
+}
+
+/**
+ * @brief Single-precision stencil over 2x4 blocks of cells
+ * Doubles the SIMD width and halves the memory traffic of
+ * WmAvxQuadBasicWaveStencil2D. Cells are square with the side
+ * of the half of the block height given by the solver.
+ * The outer lanes of the domain sides take their own values.
+ * Is bitwise equal to WmPackedBasicWaveStencil2D<float, ...> of
+ * the same block shape, which is its portable reference.
+ */
+class WmAvxOctBasicWaveStencil2D
+{
+public:
+    using TData = WmAvxOctBasicWaveData2D;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmAvxOctBasicWaveStencil2D(double dspace, double dtime)
+    {
+        double courant = TData::FFactor * dtime / (dspace / TData::NCellsY);
+        courant2_ = static_cast<float>(courant * courant);
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    WM_TARGET_AVX void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = { 
+            NLayerIdx % NMod, 
+            (NLayerIdx + NMod - 2) % NMod, 
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0) 
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0) 
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+
+        _mm256_store_ps(
+            layers[AIdx[0]][idx].intencity,
+            step<NXSide, NYSide>(
+                _mm256_load_ps(prev[idx].intencity),
+                _mm256_load_ps(prev[idx + sub_x].intencity),
+                _mm256_load_ps(prev[idx + add_x].intencity),
+                _mm256_load_ps(prev[idx + sub_y].intencity),
+                _mm256_load_ps(prev[idx + add_y].intencity),
+                _mm256_load_ps(layers[AIdx[2]][idx].intencity),
+                courant2_
+                )
+            );
+    }
+
+    /**
+     * @brief Computes the next values of the block from the loaded ones
+     * Is shared with the stencils storing blocks in other formats.
+     * @param center Block itself
+     * @param left Left neighbour (the block itself on the left side)
+     * @param right Right neighbour (the block itself on the right side)
+     * @param top Top neighbour (the block itself on the top side)
+     * @param bottom Bottom neighbour (the block itself on the bottom side)
+     * @param prev2 Block at the other time layer
+     * @param courant2 Squared Courant number
+     */
+    template<int NXSide, int NYSide>
+    WM_TARGET_AVX static __m256 step(__m256 center, 
+                                     __m256 left, __m256 right, 
+                                     __m256 top, __m256 bottom, 
+                                     __m256 prev2, float courant2)
+    {
+        // abcd|efgh (left) ABCD|EFGH -> dABC|hEFG
+        __m256 sub_x_intencity = _mm256_blend_ps(
+                _mm256_permute_ps(center, _MM_SHUFFLE(2, 1, 0, 3)),
+                _mm256_permute_ps(left, _MM_SHUFFLE(2, 1, 0, 3)),
+                0b0001'0001
+                );
+
+        // ABCD|EFGH abcd|efgh (right) -> BCDa|FGHe
+        __m256 add_x_intencity = _mm256_blend_ps(
+                _mm256_permute_ps(center, _MM_SHUFFLE(0, 3, 2, 1)),
+                _mm256_permute_ps(right, _MM_SHUFFLE(0, 3, 2, 1)),
+                0b1000'1000
+                );
+
+        // abcd|efgh (top)
+        // ABCD|EFGH -> efgh|ABCD
+        __m256 sub_y_intencity = _mm256_permute2f128_ps(
+                top, center,
+                0b0010'0001
+                );
+
+        // ABCD|EFGH
+        // abcd|efgh (bottom) -> EFGH|abcd
+        __m256 add_y_intencity = _mm256_permute2f128_ps(
+                center, bottom,
+                0b0010'0001
+                );
+
+        if constexpr (NXSide < 0)
+            sub_x_intencity = _mm256_blend_ps(sub_x_intencity, center, 
+                                              0b0001'0001);
+        if constexpr (NXSide > 0)
+            add_x_intencity = _mm256_blend_ps(add_x_intencity, center, 
+                                              0b1000'1000);
+        if constexpr (NYSide < 0)
+            sub_y_intencity = _mm256_blend_ps(sub_y_intencity, center, 
+                                              0b0000'1111);
+        if constexpr (NYSide > 0)
+            add_y_intencity = _mm256_blend_ps(add_y_intencity, center, 
+                                              0b1111'0000);
+
+        __m256 center2 = _mm256_mul_ps(_mm256_set1_ps(2.0f), center);
+
+        return _mm256_sub_ps(
+            _mm256_mul_ps(
+                _mm256_add_ps(
+                    _mm256_sub_ps(
+                        _mm256_add_ps(add_y_intencity, sub_y_intencity),
+                        center2
+                        ),
+                    _mm256_sub_ps(
+                        _mm256_add_ps(add_x_intencity, sub_x_intencity),
+                        center2
+                        )
+                    ),
+                _mm256_set1_ps(courant2)
+                ),
+            prev2
+            );
+    }
+
+private:
+    float courant2_ = 0.0f;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_AVX_OCT_BASIC_WAVE_STENCIL2D_H_
@@ -2,6 +2,7 @@
 #define WAVE_MODEL_STENCIL_AVX_QUAD_BASIC_WAVE_STENCIL2D_H_
 
 #include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
 
 #include <vector>
 #include <algorithm>
@@ -17,29 +18,28 @@
 
 namespace wave_model {
 
-struct alignas(alignof(__m256d)) WmAvxQuadBasicWaveData2D
+/**
+ * @brief Four values processed by one AVX register
+ * Is kept as plain doubles to be safely handled by the baseline code.
+ */
+struct alignas(32) WmAvxQuadBasicWaveData2D
 {
-    static const __m256d VFactor;
-    __m256d intencity;
+    static constexpr double FFactor = 1.0;
+    double intencity[4u];
 };
 
-// TODO: constexpr
-const __m256d WmAvxQuadBasicWaveData2D::VFactor = _mm256_set1_pd(1.0);
-
 template<typename TStream>
 TStream& operator << (TStream& stream, 
                       const WmAvxQuadBasicWaveData2D& wave_data)
 {
-    thread_local double buf[4u] = {};
-    _mm256_store_pd(buf, wave_data.intencity);
-
+    const double* buf = wave_data.intencity;
     stream << 0.25 * (buf[0] + buf[1] + buf[2] + buf[3]) << ' ';
 
     return stream;
 }
 
 // TODO: optimize
-class alignas(alignof(__m256d)) WmAvxQuadBasicWaveStencil2D
+class WmAvxQuadBasicWaveStencil2D
 {
 public:
     using TData = WmAvxQuadBasicWaveData2D;
@@ -49,12 +49,12 @@ public:
     static constexpr size_t NTargets = 6;
 
     WmAvxQuadBasicWaveStencil2D(double dspace, double dtime):
-        dspace_(_mm256_set1_pd(dspace)), dtime_(_mm256_set1_pd(dtime))
+        dspace_(dspace), dtime_(dtime)
     {}
 
     // TODO: to create enum for sides
     template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
-    void apply(int64_t idx, TLayer* layers) const
+    WM_TARGET_AVX void apply(int64_t idx, TLayer* layers) const
     {
         static constexpr size_t AIdx[] = { 
             NLayerIdx % NMod, 
@@ -87,19 +87,21 @@ public:
             sub_y = TLayer::template off_top<0>(idx, 1);
 
         // TODO: to dittinguish between x and y
-        __m256d inv_dspace = _mm256_div_pd(_mm256_set1_pd(1.0), dspace_);
-        __m256d courant = _mm256_mul_pd(
-                              TData::VFactor, 
-                              _mm256_mul_pd(dtime_, inv_dspace)
-                              );
-        __m256d courant2 = _mm256_mul_pd(courant, courant);
+        double inv_dspace = 1.0 / dspace_;
+        double courant = TData::FFactor * dtime_ * inv_dspace;
+        __m256d courant2 = _mm256_set1_pd(courant * courant);
+
+        auto load = [layers](size_t layer_idx, int64_t cell_idx)
+            WM_TARGET_AVX -> __m256d {
+                return _mm256_load_pd(layers[layer_idx][cell_idx].intencity);
+            };
 
         // abAB -> bA
         // cdCD -> dC
         __m256d sub_x_intencity = 
             _mm256_shuffle_pd(
-                layers[AIdx[1]][idx + sub_x].intencity, 
-                layers[AIdx[1]][idx].intencity, 
+                load(AIdx[1], idx + sub_x), 
+                load(AIdx[1], idx), 
                 0b00'00'01'01
                 );
 
@@ -107,8 +109,8 @@ public:
         // CDcd -> Dc
         __m256d add_x_intencity = 
             _mm256_shuffle_pd(
-                layers[AIdx[1]][idx].intencity, 
-                layers[AIdx[1]][idx + add_x].intencity, 
+                load(AIdx[1], idx), 
+                load(AIdx[1], idx + add_x), 
                 0b00'00'01'01
                 );
 
@@ -118,8 +120,8 @@ public:
         // CD
         __m256d sub_y_intencity = 
             _mm256_permute2f128_pd(
-                layers[AIdx[1]][idx + sub_y].intencity, 
-                layers[AIdx[1]][idx].intencity, 
+                load(AIdx[1], idx + sub_y), 
+                load(AIdx[1], idx), 
                 0b0010'0001
                 );
 
@@ -129,14 +131,14 @@ public:
         // cd
         __m256d add_y_intencity = 
             _mm256_permute2f128_pd(
-                layers[AIdx[1]][idx].intencity, 
-                layers[AIdx[1]][idx + add_y].intencity, 
+                load(AIdx[1], idx), 
+                load(AIdx[1], idx + add_y), 
                 0b0010'0001
                 );
 
         // TODO: to distinguish between x and y
-        layers[AIdx[0]][idx] = {
-            /* .intencity = */
+        _mm256_store_pd(
+            layers[AIdx[0]][idx].intencity,
             _mm256_sub_pd(
                 _mm256_mul_pd(
                     _mm256_add_pd(
@@ -144,24 +146,24 @@ public:
                             _mm256_add_pd(add_y_intencity,
                                           sub_y_intencity),
                             _mm256_mul_pd(_mm256_set1_pd(2.0), 
-                                          layers[AIdx[1]][idx].intencity)
+                                          load(AIdx[1], idx))
                             ),
                         _mm256_sub_pd(
                             _mm256_add_pd(add_x_intencity,
                                           sub_x_intencity),
                             _mm256_mul_pd(_mm256_set1_pd(2.0), 
-                                          layers[AIdx[1]][idx].intencity)
+                                          load(AIdx[1], idx))
                             )
                         ), 
                     courant2
                     ),
-                layers[AIdx[2]][idx].intencity
+                load(AIdx[2], idx)
                 )
-        };
+            );
     }
 
 private:
-    __m256d dspace_, dtime_;
+    double dspace_, dtime_;
 };
 
 } // namespace wave_model
@@ -0,0 +1,173 @@
+#ifndef WAVE_MODEL_STENCIL_AVX_VELOCITY_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_AVX_VELOCITY_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
+#include "stencil/velocity_wave_stencil2d.h"
+#include "stencil/avx_high_order_wave_stencil2d.h"
+
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include <cstdint>
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace wave_model {
+
+/**
+ * @brief Wave stencil of the heterogeneous medium over 4x4 blocks with AVX
+ * Each row of the block is processed by one AVX register, velocities
+ * are read from the shared layer with unaligned loads.
+ * Is bitwise equal to WmVelocityWaveStencil2D<TL, NRX, NRY, 4, 4>.
+ * @tparam TL Layer template of the solver
+ * @tparam NRX Domain rank along x of the solver
+ * @tparam NRY Domain rank along y of the solver
+ */
+template<template<typename, size_t, size_t> typename TL,
+         size_t NRX, size_t NRY = NRX>
+class WmAvxVelocityWaveStencil2D
+{
+public:
+    using TData = WmAvxHighOrderWaveData2D;
+    using TVelocityData = WmVelocityData2D<TData::NCellsX, TData::NCellsY>;
+    using TVelocityLayer = TL<TVelocityData, NRX, NRY>;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmAvxVelocityWaveStencil2D(double dspace, double dtime,
+                               std::shared_ptr<const TVelocityLayer> velocity):
+        velocity_(std::move(velocity))
+    {
+        WM_ASSERT(velocity_, "velocity layer is required");
+
+        double inv_dspace = 1.0 / (dspace / TData::NCellsY);
+        double courant = TData::FFactor * dtime * inv_dspace;
+        courant2_ = courant * courant;
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    WM_TARGET_AVX void apply(int64_t idx, TLayer* layers) const
+    {
+        static_assert(std::is_same_v<TLayer, TL<TData, NRX, NRY>>,
+                      "velocity must be laid out as the wave layers");
+
+        static constexpr size_t AIdx[] = {
+            NLayerIdx % NMod,
+            (NLayerIdx + NMod - 2) % NMod,
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        static constexpr int64_t NRows = TData::NCellsY;
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0)
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0)
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+        const double* velocity = (*velocity_)[idx].velocity;
+
+        auto load = [&prev](int64_t block_idx, int64_t row)
+            WM_TARGET_AVX -> __m256d {
+                return _mm256_load_pd(prev[block_idx].intencity + 4 * row);
+            };
+
+        __m256d courant2 = _mm256_set1_pd(courant2_);
+        __m256d results[NRows];
+
+        for (int64_t row = 0; row < NRows; ++row)
+        {
+            __m256d center = load(idx, row);
+
+            // cells out of the domain take the nearest side values
+            __m256d top = center;
+            if (row > 0)
+                top = load(idx, row - 1);
+            else if constexpr (NYSide >= 0)
+                top = load(idx + sub_y, NRows - 1);
+
+            __m256d bottom = center;
+            if (row + 1 < NRows)
+                bottom = load(idx, row + 1);
+            else if constexpr (NYSide <= 0)
+                bottom = load(idx + add_y, 0);
+
+            __m256d left;
+            if constexpr (NXSide < 0)
+            {
+                left = _mm256_permute_pd(center, 0b0000);
+                left = _mm256_permute2f128_pd(left, left, 0x00);
+            }
+            else
+                left = load(idx + sub_x, row);
+
+            __m256d right;
+            if constexpr (NXSide > 0)
+            {
+                right = _mm256_permute_pd(center, 0b1111);
+                right = _mm256_permute2f128_pd(right, right, 0x11);
+            }
+            else
+                right = load(idx + add_x, row);
+
+            // l3 c0 c1 c2 and c1 c2 c3 r0
+            __m256d sub_x_row = _mm256_shuffle_pd(
+                    _mm256_permute2f128_pd(left, center, 0x21),
+                    center, 0b0101);
+            __m256d add_x_row = _mm256_shuffle_pd(
+                    center,
+                    _mm256_permute2f128_pd(center, right, 0x21), 0b0101);
+
+            __m256d value2 = _mm256_mul_pd(_mm256_set1_pd(2.0), center);
+            __m256d speed = _mm256_loadu_pd(velocity + 4 * row);
+
+            results[row] = _mm256_sub_pd(
+                _mm256_mul_pd(
+                    _mm256_add_pd(
+                        _mm256_sub_pd(_mm256_add_pd(bottom, top), value2),
+                        _mm256_sub_pd(_mm256_add_pd(add_x_row, sub_x_row),
+                                      value2)
+                        ),
+                    _mm256_mul_pd(_mm256_mul_pd(speed, speed), courant2)
+                    ),
+                _mm256_load_pd(layers[AIdx[2]][idx].intencity + 4 * row)
+                );
+        }
+
+        // the target block is the center one
+        for (int64_t row = 0; row < NRows; ++row)
+            _mm256_store_pd(layers[AIdx[0]][idx].intencity + 4 * row,
+                            results[row]);
+    }
+
+private:
+    std::shared_ptr<const TVelocityLayer> velocity_;
+    double courant2_ = 0.0;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_AVX_VELOCITY_WAVE_STENCIL2D_H_
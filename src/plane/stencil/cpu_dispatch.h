@@ -0,0 +1,115 @@
+#ifndef WAVE_MODEL_STENCIL_CPU_DISPATCH_H_
+#define WAVE_MODEL_STENCIL_CPU_DISPATCH_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Vector kernels are compiled for their instruction sets with these
+ * attributes while the rest of the binary keeps the baseline ISA,
+ * so the kernels must not be called before WmCpuDispatch approves them.
+ * Data passed between the baseline code and the kernels must not contain
+ * vector types: their calling convention depends on the enabled ISA.
+ */
+#define WM_TARGET_AVX      __attribute__((target("avx")))
+#define WM_TARGET_AVX_F16C __attribute__((target("avx,f16c")))
+#define WM_TARGET_AVX2_FMA __attribute__((target("avx2,fma,f16c")))
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief Detects the vector extensions of the host at runtime
+ * Instruction sets are ordered, each one implies all the preceding.
+ * WM_ISA environment variable (scalar, avx, avx_f16c, avx2_fma) limits
+ * the choice, e.g. to check the fallbacks on the newer host.
+ */
+struct WmCpuDispatch
+{
+    enum EIsa
+    {
+        ISA_SCALAR,
+        ISA_AVX,
+        ISA_AVX_F16C,
+        ISA_AVX2_FMA,
+        ISA_COUNT
+    };
+
+    // allow only namespace-like usage
+    WmCpuDispatch() = delete;
+
+    /**
+     * @brief Returns printable name of the instruction set
+     */
+    static const char* name(EIsa isa) noexcept
+    {
+        static constexpr const char* NNames[] = {
+            "scalar", "avx", "avx_f16c", "avx2_fma"
+        };
+
+        return isa < ISA_COUNT ? NNames[isa] : "unknown";
+    }
+
+    /**
+     * @brief Checks whether the host CPU and OS support the instruction set
+     */
+    static bool supports(EIsa isa) noexcept
+    {
+        switch (isa)
+        {
+            case ISA_SCALAR:
+                return true;
+            case ISA_AVX:
+                return __builtin_cpu_supports("avx");
+            case ISA_AVX_F16C:
+                return __builtin_cpu_supports("avx") &&
+                       __builtin_cpu_supports("f16c");
+            case ISA_AVX2_FMA:
+                return __builtin_cpu_supports("avx2") &&
+                       __builtin_cpu_supports("fma") &&
+                       __builtin_cpu_supports("f16c");
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Returns the best supported instruction set
+     * Is computed once, so it's cheap to call before each run.
+     */
+    static EIsa select() noexcept
+    {
+        static const EIsa isa = detect();
+        return isa;
+    }
+
+private:
+    static EIsa detect() noexcept
+    {
+        EIsa limit = static_cast<EIsa>(ISA_COUNT - 1);
+
+        if (const char* env = std::getenv("WM_ISA"))
+        {
+            for (int idx = 0; idx < ISA_COUNT; ++idx)
+            {
+                if (std::strcmp(env, name(static_cast<EIsa>(idx))) == 0)
+                    limit = static_cast<EIsa>(idx);
+            }
+        }
+
+        while (limit > ISA_SCALAR && !supports(limit))
+            limit = static_cast<EIsa>(limit - 1);
+
+        return limit;
+    }
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_CPU_DISPATCH_H_
@@ -0,0 +1,136 @@
+#ifndef WAVE_MODEL_STENCIL_F16C_OCT_BASIC_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_F16C_OCT_BASIC_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
+#include "stencil/half.h"
+#include "stencil/avx_oct_basic_wave_stencil2d.h"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace wave_model {
+
+/**
+ * @brief Eight half-precision cells of the 2x4 block
+ * Lanes are ordered as in WmAvxOctBasicWaveData2D.
+ */
+struct alignas(16) WmF16cOctBasicWaveData2D
+{
+    static constexpr float FFactor = 1.0f;
+    static constexpr size_t NCellsX = 4;
+    static constexpr size_t NCellsY = 2;
+
+    WmHalf intencity[NCellsX * NCellsY];
+};
+
+template<typename TStream>
+TStream& operator << (TStream& stream,
+                      const WmF16cOctBasicWaveData2D& wave_data)
+{
+    const WmHalf* buf = wave_data.intencity;
+    for (size_t idx = 0; idx < 8u; ++idx)
+        stream << static_cast<float>(buf[idx]) << (idx + 1 < 8u ? " " : "");
+
+    return stream;
+}
+
+/**
+ * @brief Stencil over 2x4 blocks stored in half precision
+ * Widens the blocks to float with F16C on load and narrows them back
+ * on store, the computations are the ones of WmAvxOctBasicWaveStencil2D.
+ * Takes a quarter of the bytes of the double stencils per cell,
+ * so it's meant for the domains exceeding the caches.
+ * Is bitwise equal to WmPackedBasicWaveStencil2D<float, 4, 2, WmHalf>.
+ */
+class WmF16cOctBasicWaveStencil2D
+{
+public:
+    using TData = WmF16cOctBasicWaveData2D;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmF16cOctBasicWaveStencil2D(double dspace, double dtime)
+    {
+        double courant = TData::FFactor * dtime / (dspace / TData::NCellsY);
+        courant2_ = static_cast<float>(courant * courant);
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    WM_TARGET_AVX_F16C void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = {
+            NLayerIdx % NMod,
+            (NLayerIdx + NMod - 2) % NMod,
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0)
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0)
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+
+        store(
+            layers[AIdx[0]][idx].intencity,
+            WmAvxOctBasicWaveStencil2D::step<NXSide, NYSide>(
+                load(prev[idx].intencity),
+                load(prev[idx + sub_x].intencity),
+                load(prev[idx + add_x].intencity),
+                load(prev[idx + sub_y].intencity),
+                load(prev[idx + add_y].intencity),
+                load(layers[AIdx[2]][idx].intencity),
+                courant2_
+                )
+            );
+    }
+
+    /**
+     * @brief Widens eight 16-byte aligned halves to floats
+     */
+    WM_TARGET_AVX_F16C static __m256 load(const WmHalf* halves)
+    {
+        return _mm256_cvtph_ps(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(halves)));
+    }
+
+    /**
+     * @brief Narrows eight floats to 16-byte aligned halves
+     * Rounds to the nearest even as WmHalf does.
+     */
+    WM_TARGET_AVX_F16C static void store(WmHalf* halves, __m256 values)
+    {
+        _mm_store_si128(reinterpret_cast<__m128i*>(halves),
+                        _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+    }
+
+private:
+    float courant2_ = 0.0f;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_F16C_OCT_BASIC_WAVE_STENCIL2D_H_
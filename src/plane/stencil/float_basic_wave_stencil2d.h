@@ -0,0 +1,95 @@
+#ifndef WAVE_MODEL_STENCIL_FLOAT_BASIC_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_FLOAT_BASIC_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+
+#include <cstdint>
+#include <cstddef>
+
+namespace wave_model {
+
+struct WmFloatBasicWaveData2D
+{
+    static constexpr float FFactor = 1.0f;
+    float intencity;
+};
+
+template<typename TStream>
+TStream& operator << (TStream& stream, const WmFloatBasicWaveData2D& wave_data)
+{
+    stream << wave_data.intencity;
+    return stream;
+}
+
+/**
+ * @brief Single-precision WmBasicWaveStencil2D
+ * Applies the same operations in the same order, so it differs from
+ * the double stencil on the same grid only by the rounding.
+ */
+class WmFloatBasicWaveStencil2D
+{
+public:
+    using TData = WmFloatBasicWaveData2D;
+    static constexpr size_t NDepth = 2;
+    constexpr static size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmFloatBasicWaveStencil2D(double dspace, double dtime)
+    {
+        double courant = TData::FFactor * dtime / dspace;
+        courant2_ = static_cast<float>(courant * courant);
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = { 
+            NLayerIdx % NMod, 
+            (NLayerIdx + NMod - 2) % NMod, 
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0) 
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0) 
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+        float center = prev[idx].intencity;
+
+        layers[AIdx[0]][idx] = {
+            /* .intencity = */
+                ((prev[idx + add_y].intencity + 
+                  prev[idx + sub_y].intencity - 2.0f * center) + 
+                 (prev[idx + add_x].intencity + 
+                  prev[idx + sub_x].intencity - 2.0f * center)
+                 ) * courant2_ - layers[AIdx[2]][idx].intencity
+        };
+    }
+
+private:
+    float courant2_ = 0.0f;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_FLOAT_BASIC_WAVE_STENCIL2D_H_
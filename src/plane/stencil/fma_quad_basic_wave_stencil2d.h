@@ -0,0 +1,127 @@
+#ifndef WAVE_MODEL_STENCIL_FMA_QUAD_BASIC_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_FMA_QUAD_BASIC_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
+#include "stencil/avx_quad_basic_wave_stencil2d.h"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace wave_model {
+
+/**
+ * @brief WmAvxQuadBasicWaveStencil2D for AVX2 and FMA capable hosts
+ * Shares the data packing with the AVX stencil, fuses the Laplacian
+ * and the time step into two FMAs and precomputes the squared Courant
+ * number, so results may differ from the AVX stencil in the last bits.
+ */
+class WmFmaQuadBasicWaveStencil2D
+{
+public:
+    using TData = WmAvxQuadBasicWaveData2D;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmFmaQuadBasicWaveStencil2D(double dspace, double dtime)
+    {
+        double courant = TData::FFactor * dtime / dspace;
+        courant2_ = courant * courant;
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    WM_TARGET_AVX2_FMA void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = { 
+            NLayerIdx % NMod, 
+            (NLayerIdx + NMod - 2) % NMod, 
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0) 
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0) 
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+
+        __m256d center = _mm256_load_pd(prev[idx].intencity);
+
+        // abAB -> bA
+        // cdCD -> dC
+        __m256d sub_x_intencity = _mm256_shuffle_pd(
+                _mm256_load_pd(prev[idx + sub_x].intencity), center, 
+                0b00'00'01'01
+                );
+
+        // ABab -> Ba
+        // CDcd -> Dc
+        __m256d add_x_intencity = _mm256_shuffle_pd(
+                center, _mm256_load_pd(prev[idx + add_x].intencity), 
+                0b00'00'01'01
+                );
+
+        // ab
+        // cd -> cd
+        // AB -> AB
+        // CD
+        __m256d sub_y_intencity = _mm256_permute2f128_pd(
+                _mm256_load_pd(prev[idx + sub_y].intencity), center, 
+                0b0010'0001
+                );
+
+        // AB
+        // CD -> CD
+        // ab -> ab
+        // cd
+        __m256d add_y_intencity = _mm256_permute2f128_pd(
+                center, _mm256_load_pd(prev[idx + add_y].intencity), 
+                0b0010'0001
+                );
+
+        __m256d laplacian = _mm256_fnmadd_pd(
+                _mm256_set1_pd(4.0), center,
+                _mm256_add_pd(
+                    _mm256_add_pd(add_y_intencity, sub_y_intencity),
+                    _mm256_add_pd(add_x_intencity, sub_x_intencity)
+                    )
+                );
+
+        _mm256_store_pd(
+            layers[AIdx[0]][idx].intencity,
+            _mm256_fmsub_pd(
+                laplacian, _mm256_set1_pd(courant2_),
+                _mm256_load_pd(layers[AIdx[2]][idx].intencity)
+                )
+            );
+    }
+
+private:
+    double courant2_ = 0.0;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_FMA_QUAD_BASIC_WAVE_STENCIL2D_H_
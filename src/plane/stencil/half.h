@@ -0,0 +1,120 @@
+#ifndef WAVE_MODEL_STENCIL_HALF_H_
+#define WAVE_MODEL_STENCIL_HALF_H_
+
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ */
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+/// @brief
+namespace wave_model {
+
+/**
+ * @brief IEEE 754 binary16 value for the storage only
+ * Values are widened to float for the computations. Conversions round
+ * to the nearest even as F16C instructions do, so the portable code
+ * reads and writes the same bits as the vector kernels.
+ */
+class WmHalf
+{
+public:
+    WmHalf() = default;
+
+    explicit WmHalf(float value) noexcept:
+        bits_{ from_float(value) }
+    {}
+
+    operator float() const noexcept
+    {
+        return to_float(bits_);
+    }
+
+    uint16_t bits() const noexcept
+    {
+        return bits_;
+    }
+
+private:
+    static uint16_t from_float(float value) noexcept
+    {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        uint32_t abs = bits & 0x7FFF'FFFFu;
+
+        // infinity or NaN (quiet, keeping the upper payload bits)
+        if (abs >= 0x7F80'0000u)
+        {
+            uint32_t payload = abs > 0x7F80'0000u ? 
+                0x0200u | ((abs >> 13) & 0x03FFu) : 0u;
+
+            return static_cast<uint16_t>(sign | 0x7C00u | payload);
+        }
+
+        // 65520 and above round to infinity
+        if (abs >= 0x477F'F000u)
+            return static_cast<uint16_t>(sign | 0x7C00u);
+
+        // normal half: rebias the exponent, round the mantissa
+        if (abs >= 0x3880'0000u)
+        {
+            abs += 0x0FFFu + ((abs >> 13) & 1u);
+            return static_cast<uint16_t>(sign | ((abs - 0x3800'0000u) >> 13));
+        }
+
+        // 2^-25 and below round to zero
+        if (abs <= 0x3300'0000u)
+            return static_cast<uint16_t>(sign);
+
+        // subnormal half: the units of 2^-24
+        uint32_t shift = 126u - (abs >> 23);
+        uint32_t mantissa = (abs & 0x007F'FFFFu) | 0x0080'0000u;
+        uint32_t result = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+
+        if (rest > halfway || (rest == halfway && (result & 1u)))
+            ++result;
+
+        return static_cast<uint16_t>(sign | result);
+    }
+
+    static float to_float(uint16_t half) noexcept
+    {
+        uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        uint32_t exponent = (half >> 10) & 0x1Fu;
+        uint32_t mantissa = half & 0x03FFu;
+
+        if (exponent == 0)
+        {
+            float value = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -value : value;
+        }
+
+        uint32_t bits = sign | (mantissa << 13) | (exponent + 112u) << 23;
+
+        // infinity or NaN (quiet)
+        if (exponent == 0x1Fu)
+            bits = sign | 0x7F80'0000u | (mantissa ? 0x0040'0000u : 0u) | 
+                   (mantissa << 13);
+
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        return value;
+    }
+
+    uint16_t bits_ = 0;
+};
+
+static_assert(sizeof(WmHalf) == 2, "WmHalf must be packed into 2 bytes");
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_HALF_H_
@@ -0,0 +1,200 @@
+#ifndef WAVE_MODEL_STENCIL_HIGH_ORDER_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_HIGH_ORDER_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/packed_basic_wave_stencil2d.h"
+
+#include <cstdint>
+#include <cstddef>
+
+namespace wave_model {
+
+/**
+ * @brief Central differences of the second derivative
+ * Are of the order 2 * NRadius: NCoeffs[k] weights the sum of cells
+ * at the distance k (NCoeffs[0] weights the cell itself).
+ * @tparam NRadius Stencil radius from 1 to 4
+ */
+template<size_t NRadius>
+struct WmHighOrderCoeffs;
+
+template<>
+struct WmHighOrderCoeffs<1>
+{
+    static constexpr double NCoeffs[] = { -2.0, 1.0 };
+};
+
+template<>
+struct WmHighOrderCoeffs<2>
+{
+    static constexpr double NCoeffs[] = {
+        -5.0 / 2.0, 4.0 / 3.0, -1.0 / 12.0
+    };
+};
+
+template<>
+struct WmHighOrderCoeffs<3>
+{
+    static constexpr double NCoeffs[] = {
+        -49.0 / 18.0, 3.0 / 2.0, -3.0 / 20.0, 1.0 / 90.0
+    };
+};
+
+template<>
+struct WmHighOrderCoeffs<4>
+{
+    static constexpr double NCoeffs[] = {
+        -205.0 / 72.0, 8.0 / 5.0, -1.0 / 5.0, 8.0 / 315.0, -1.0 / 560.0
+    };
+};
+
+/**
+ * @brief Wave stencil of the order 2 * NRadius over blocks of cells
+ *
+ * Tilings advance their unit by one per step, so radius of the stencil
+ * over cells must not exceed the block sides: then each block depends
+ * only on its four neighbours, as the cell of WmBasicWaveStencil2D does,
+ * and ConeFold and DiamondTorre tilings run unchanged with the cone
+ * slope of the block side in cells.
+ * Cells out of the domain take the value of the nearest side cell,
+ * so NRadius = 1 over single cells is bitwise equal to
+ * WmBasicWaveStencil2D. Is the portable reference of
+ * WmAvxHighOrderWaveStencil2D over 4x4 blocks.
+ *
+ * @tparam NRadius Stencil radius from 1 to 4
+ * @tparam NCellsX Cells in the block row
+ * @tparam NCellsY Cells in the block column
+ */
+template<size_t NRadius,
+         size_t NCellsX = NRadius, size_t NCellsY = NRadius>
+class WmHighOrderWaveStencil2D
+{
+public:
+    static_assert(NRadius <= NCellsX && NRadius <= NCellsY,
+                  "stencil must not exceed the neighbour blocks");
+
+    using TData = WmPackedBasicWaveData2D<double, NCellsX, NCellsY>;
+    using TCoeffs = WmHighOrderCoeffs<NRadius>;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmHighOrderWaveStencil2D(double dspace, double dtime)
+    {
+        double inv_dspace = 1.0 / (dspace / NCellsY);
+        double courant = TData::FFactor * dtime * inv_dspace;
+        courant2_ = courant * courant;
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = {
+            NLayerIdx % NMod,
+            (NLayerIdx + NMod - 2) % NMod,
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0)
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0)
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+        const double* center = prev[idx].intencity;
+        const double* left = prev[idx + sub_x].intencity;
+        const double* right = prev[idx + add_x].intencity;
+        const double* top = prev[idx + sub_y].intencity;
+        const double* bottom = prev[idx + add_y].intencity;
+
+        // cell of the block row or of the row neighbours
+        auto at_x = [=](int64_t y_idx, int64_t x_idx)
+        {
+            int64_t row = y_idx * NCellsX;
+
+            if (x_idx < 0)
+                return NXSide < 0 ? center[row] : left[row + NCellsX + x_idx];
+            if (x_idx >= static_cast<int64_t>(NCellsX))
+                return NXSide > 0 ? center[row + NCellsX - 1] :
+                                    right[row + x_idx - NCellsX];
+
+            return center[row + x_idx];
+        };
+
+        // cell of the block column or of the column neighbours
+        auto at_y = [=](int64_t y_idx, int64_t x_idx)
+        {
+            static constexpr int64_t NLast = (NCellsY - 1) * NCellsX;
+
+            if (y_idx < 0)
+                return NYSide < 0 ? center[x_idx] :
+                                    top[(NCellsY + y_idx) * NCellsX + x_idx];
+            if (y_idx >= static_cast<int64_t>(NCellsY))
+                return NYSide > 0 ? center[NLast + x_idx] :
+                                    bottom[(y_idx - NCellsY) * NCellsX + x_idx];
+
+            return center[y_idx * NCellsX + x_idx];
+        };
+
+        // the target block is the center one
+        double result[NCellsX * NCellsY];
+
+        for (int64_t y_idx = 0; y_idx < static_cast<int64_t>(NCellsY); ++y_idx)
+        for (int64_t x_idx = 0; x_idx < static_cast<int64_t>(NCellsX); ++x_idx)
+        {
+            static constexpr int64_t NR = NRadius;
+
+            double value = center[y_idx * NCellsX + x_idx];
+
+            // the farthest terms are the smallest ones
+            double lap_y = TCoeffs::NCoeffs[NR] *
+                (at_y(y_idx + NR, x_idx) + at_y(y_idx - NR, x_idx));
+            double lap_x = TCoeffs::NCoeffs[NR] *
+                (at_x(y_idx, x_idx + NR) + at_x(y_idx, x_idx - NR));
+
+            for (int64_t dist = NR - 1; dist > 0; --dist)
+            {
+                lap_y += TCoeffs::NCoeffs[dist] *
+                    (at_y(y_idx + dist, x_idx) + at_y(y_idx - dist, x_idx));
+                lap_x += TCoeffs::NCoeffs[dist] *
+                    (at_x(y_idx, x_idx + dist) + at_x(y_idx, x_idx - dist));
+            }
+
+            lap_y += TCoeffs::NCoeffs[0] * value;
+            lap_x += TCoeffs::NCoeffs[0] * value;
+
+            result[y_idx * NCellsX + x_idx] =
+                (lap_y + lap_x) * courant2_ -
+                layers[AIdx[2]][idx].intencity[y_idx * NCellsX + x_idx];
+        }
+
+        for (size_t cell = 0; cell < NCellsX * NCellsY; ++cell)
+            layers[AIdx[0]][idx].intencity[cell] = result[cell];
+    }
+
+private:
+    double courant2_ = 0.0;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_HIGH_ORDER_WAVE_STENCIL2D_H_
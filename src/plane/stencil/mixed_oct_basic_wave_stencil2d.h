@@ -0,0 +1,136 @@
+#ifndef WAVE_MODEL_STENCIL_MIXED_OCT_BASIC_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_MIXED_OCT_BASIC_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/cpu_dispatch.h"
+#include "stencil/half.h"
+#include "stencil/avx_oct_basic_wave_stencil2d.h"
+#include "stencil/f16c_oct_basic_wave_stencil2d.h"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace wave_model {
+
+/**
+ * @brief 2x4 block keeping both time layers of the cells
+ * Odd layers (the initial and the resulting ones) are stored in float,
+ * even layers in half precision: 6 bytes per cell instead of 8 of
+ * the two float layers. Lanes are ordered as in WmAvxOctBasicWaveData2D.
+ */
+struct alignas(16) WmMixedOctBasicWaveData2D
+{
+    static constexpr float FFactor = 1.0f;
+    static constexpr size_t NCellsX = 4;
+    static constexpr size_t NCellsY = 2;
+
+    float intencity[NCellsX * NCellsY];
+    WmHalf even_intencity[NCellsX * NCellsY];
+};
+
+template<typename TStream>
+TStream& operator << (TStream& stream,
+                      const WmMixedOctBasicWaveData2D& wave_data)
+{
+    const float* buf = wave_data.intencity;
+    for (size_t idx = 0; idx < 8u; ++idx)
+        stream << buf[idx] << (idx + 1 < 8u ? " " : "");
+
+    return stream;
+}
+
+/**
+ * @brief Stencil over 2x4 blocks keeping only one time layer in float
+ * Both time layers live in the same block (NMod is 1 while NDepth is 2),
+ * the even ones are narrowed to half precision with F16C.
+ * Otherwise computes the same as WmAvxOctBasicWaveStencil2D.
+ * Requires the tiling depth of 2 layers at least for the layers parity
+ * to be the same in each traversal.
+ */
+class WmMixedOctBasicWaveStencil2D
+{
+public:
+    using TData = WmMixedOctBasicWaveData2D;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = 1;
+
+    static constexpr size_t NTargets = 6;
+
+    WmMixedOctBasicWaveStencil2D(double dspace, double dtime)
+    {
+        double courant = TData::FFactor * dtime / (dspace / TData::NCellsY);
+        courant2_ = static_cast<float>(courant * courant);
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    WM_TARGET_AVX_F16C void apply(int64_t idx, TLayer* layers) const
+    {
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0)
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0)
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        auto& layer = layers[0];
+
+        if constexpr (NLayerIdx % NDepth == 0)
+        {
+            using TF16c = WmF16cOctBasicWaveStencil2D;
+
+            TF16c::store(
+                layer[idx].even_intencity,
+                WmAvxOctBasicWaveStencil2D::step<NXSide, NYSide>(
+                    TF16c::load(layer[idx].even_intencity),
+                    TF16c::load(layer[idx + sub_x].even_intencity),
+                    TF16c::load(layer[idx + add_x].even_intencity),
+                    TF16c::load(layer[idx + sub_y].even_intencity),
+                    TF16c::load(layer[idx + add_y].even_intencity),
+                    _mm256_loadu_ps(layer[idx].intencity),
+                    courant2_
+                    )
+                );
+        }
+        else
+        {
+            _mm256_storeu_ps(
+                layer[idx].intencity,
+                WmAvxOctBasicWaveStencil2D::step<NXSide, NYSide>(
+                    _mm256_loadu_ps(layer[idx].intencity),
+                    _mm256_loadu_ps(layer[idx + sub_x].intencity),
+                    _mm256_loadu_ps(layer[idx + add_x].intencity),
+                    _mm256_loadu_ps(layer[idx + sub_y].intencity),
+                    _mm256_loadu_ps(layer[idx + add_y].intencity),
+                    WmF16cOctBasicWaveStencil2D::load(
+                        layer[idx].even_intencity),
+                    courant2_
+                    )
+                );
+        }
+    }
+
+private:
+    float courant2_ = 0.0f;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_MIXED_OCT_BASIC_WAVE_STENCIL2D_H_
@@ -0,0 +1,150 @@
+#ifndef WAVE_MODEL_STENCIL_PACKED_BASIC_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_PACKED_BASIC_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/half.h"
+
+#include <cstdint>
+#include <cstddef>
+
+namespace wave_model {
+
+/**
+ * @brief Block of NCellsY x NCellsX cells stored row by row
+ * @tparam TStorage Storage type of the cells (double, float or WmHalf)
+ */
+template<typename TStorage, size_t NCellsX_, size_t NCellsY_>
+struct WmPackedBasicWaveData2D
+{
+    static constexpr double FFactor = 1.0;
+    static constexpr size_t NCellsX = NCellsX_;
+    static constexpr size_t NCellsY = NCellsY_;
+
+    TStorage intencity[NCellsX * NCellsY];
+};
+
+template<typename TStream, typename TStorage, size_t NCellsX, size_t NCellsY>
+TStream& operator << (
+        TStream& stream,
+        const WmPackedBasicWaveData2D<TStorage, NCellsX, NCellsY>& wave_data)
+{
+    static constexpr size_t NCellsCnt = NCellsX * NCellsY;
+
+    for (size_t idx = 0; idx < NCellsCnt; ++idx)
+        stream << static_cast<double>(wave_data.intencity[idx]) 
+               << (idx + 1 < NCellsCnt ? " " : "");
+
+    return stream;
+}
+
+/**
+ * @brief Portable stencil over the blocks of cells
+ * Updates the whole block at once from the values it had before,
+ * like the vector stencils do, so it is their portable reference:
+ * WmPackedBasicWaveStencil2D<float, 4, 2> and <float, 8, 1> are
+ * bitwise equal to WmAvxOctBasicWaveStencil2D and
+ * WmAvxOctAxisBasicWaveStencil2D, <float, 4, 2, WmHalf> is equal to
+ * WmF16cOctBasicWaveStencil2D, while the double ones measure
+ * the rounding error of the reduced precisions.
+ * @tparam TValue Value type of the computations
+ * @tparam TStorage Storage type of the cells
+ */
+template<typename TValue, size_t NCellsX, size_t NCellsY, 
+         typename TStorage = TValue>
+class WmPackedBasicWaveStencil2D
+{
+public:
+    using TData = WmPackedBasicWaveData2D<TStorage, NCellsX, NCellsY>;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmPackedBasicWaveStencil2D(double dspace, double dtime)
+    {
+        double courant = TData::FFactor * dtime / (dspace / NCellsY);
+        courant2_ = static_cast<TValue>(courant * courant);
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    void apply(int64_t idx, TLayer* layers) const
+    {
+        static constexpr size_t AIdx[] = {
+            NLayerIdx % NMod,
+            (NLayerIdx + NMod - 2) % NMod,
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0)
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0)
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+        const TStorage* center = prev[idx].intencity;
+
+        // the target block is the center one
+        TValue result[NCellsX * NCellsY];
+
+        for (size_t y_idx = 0; y_idx < NCellsY; ++y_idx)
+        for (size_t x_idx = 0; x_idx < NCellsX; ++x_idx)
+        {
+            size_t cell = y_idx * NCellsX + x_idx;
+            TValue value = static_cast<TValue>(center[cell]);
+
+            TValue sub_x_value = static_cast<TValue>(
+                x_idx > 0 ? center[cell - 1] :
+                NXSide < 0 ? center[cell] :
+                prev[idx + sub_x].intencity[cell + NCellsX - 1]);
+            TValue add_x_value = static_cast<TValue>(
+                x_idx + 1 < NCellsX ? center[cell + 1] :
+                NXSide > 0 ? center[cell] :
+                prev[idx + add_x].intencity[cell + 1 - NCellsX]);
+            TValue sub_y_value = static_cast<TValue>(
+                y_idx > 0 ? center[cell - NCellsX] :
+                NYSide < 0 ? center[cell] :
+                prev[idx + sub_y].intencity[cell + (NCellsY - 1) * NCellsX]);
+            TValue add_y_value = static_cast<TValue>(
+                y_idx + 1 < NCellsY ? center[cell + NCellsX] :
+                NYSide > 0 ? center[cell] :
+                prev[idx + add_y].intencity[x_idx]);
+
+            TValue value2 = TValue{ 2 } * value;
+
+            result[cell] =
+                ((add_y_value + sub_y_value - value2) +
+                 (add_x_value + sub_x_value - value2)
+                 ) * courant2_ - 
+                static_cast<TValue>(layers[AIdx[2]][idx].intencity[cell]);
+        }
+
+        for (size_t cell = 0; cell < NCellsX * NCellsY; ++cell)
+            layers[AIdx[0]][idx].intencity[cell] = 
+                static_cast<TStorage>(result[cell]);
+    }
+
+private:
+    TValue courant2_ = TValue{};
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_PACKED_BASIC_WAVE_STENCIL2D_H_
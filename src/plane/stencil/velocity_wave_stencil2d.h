@@ -0,0 +1,159 @@
+#ifndef WAVE_MODEL_STENCIL_VELOCITY_WAVE_STENCIL2D_H_
+#define WAVE_MODEL_STENCIL_VELOCITY_WAVE_STENCIL2D_H_
+
+#include "logging/macro.h"
+#include "stencil/packed_basic_wave_stencil2d.h"
+
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace wave_model {
+
+/**
+ * @brief Velocities of the medium in the block of NCellsY x NCellsX cells
+ * Cells are stored row by row as in WmPackedBasicWaveData2D.
+ */
+template<size_t NCellsX_, size_t NCellsY_>
+struct WmVelocityData2D
+{
+    static constexpr size_t NCellsX = NCellsX_;
+    static constexpr size_t NCellsY = NCellsY_;
+
+    double velocity[NCellsX * NCellsY];
+};
+
+/**
+ * @brief Wave stencil of the heterogeneous medium over blocks of cells
+ *
+ * Takes the velocity of each cell from the read-only layer laid out
+ * as the wave layers are (TL<TData, NRX, NRY>), so the tiling streams
+ * it with the same locality. The layer is shared by all the solvers
+ * (and their copies of the stencil), it is never copied.
+ * The layer keeps the velocities themselves, independent of the grid
+ * steps: the stencil squares the stored velocity on each apply() and
+ * multiplies it by its own (dt/dx)^2. The velocity of 1 gives the result
+ * bitwise equal to WmPackedBasicWaveStencil2D<double, NCellsX, NCellsY>
+ * (and to WmBasicWaveStencil2D over single cells).
+ *
+ * @tparam TL Layer template of the solver
+ * @tparam NRX Domain rank along x of the solver
+ * @tparam NRY Domain rank along y of the solver
+ * @tparam NCellsX Cells in the block row
+ * @tparam NCellsY Cells in the block column
+ */
+template<template<typename, size_t, size_t> typename TL,
+         size_t NRX, size_t NRY = NRX,
+         size_t NCellsX = 1, size_t NCellsY = 1>
+class WmVelocityWaveStencil2D
+{
+public:
+    using TData = WmPackedBasicWaveData2D<double, NCellsX, NCellsY>;
+    using TVelocityData = WmVelocityData2D<NCellsX, NCellsY>;
+    using TVelocityLayer = TL<TVelocityData, NRX, NRY>;
+    static constexpr size_t NDepth = 2;
+    static constexpr size_t NMod = NDepth;
+
+    static constexpr size_t NTargets = 6;
+
+    WmVelocityWaveStencil2D(double dspace, double dtime,
+                            std::shared_ptr<const TVelocityLayer> velocity):
+        velocity_(std::move(velocity))
+    {
+        WM_ASSERT(velocity_, "velocity layer is required");
+
+        double inv_dspace = 1.0 / (dspace / NCellsY);
+        double courant = TData::FFactor * dtime * inv_dspace;
+        courant2_ = courant * courant;
+    }
+
+    // TODO: to create enum for sides
+    template<int NXSide, int NYSide, size_t NLayerIdx, typename TLayer>
+    void apply(int64_t idx, TLayer* layers) const
+    {
+        static_assert(std::is_same_v<TLayer, TL<TData, NRX, NRY>>,
+                      "velocity must be laid out as the wave layers");
+
+        static constexpr size_t AIdx[] = {
+            NLayerIdx % NMod,
+            (NLayerIdx + NMod - 2) % NMod,
+            (NLayerIdx + NMod - 1) % NMod
+        };
+
+        int64_t add_y = TLayer::template off_top<0>(idx, 1);
+        int64_t add_x = TLayer::template off_left<0>(idx, 1);
+
+        idx += add_x + add_y;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide > 0) add_x = 0;
+        else add_x = -add_x;
+
+        if constexpr (NYSide > 0) add_y = 0;
+        else add_y = -add_y;
+
+        int64_t sub_x = 0;
+        int64_t sub_y = 0;
+
+        // TODO: to compare with enum
+        if constexpr (NXSide >= 0)
+            sub_x = TLayer::template off_left<0>(idx, 1);
+
+        if constexpr (NYSide >= 0)
+            sub_y = TLayer::template off_top<0>(idx, 1);
+
+        const auto& prev = layers[AIdx[1]];
+        const double* center = prev[idx].intencity;
+        const double* velocity = (*velocity_)[idx].velocity;
+
+        // the target block is the center one
+        double result[NCellsX * NCellsY];
+
+        for (size_t y_idx = 0; y_idx < NCellsY; ++y_idx)
+        for (size_t x_idx = 0; x_idx < NCellsX; ++x_idx)
+        {
+            size_t cell = y_idx * NCellsX + x_idx;
+            double value = center[cell];
+
+            double sub_x_value =
+                x_idx > 0 ? center[cell - 1] :
+                NXSide < 0 ? center[cell] :
+                prev[idx + sub_x].intencity[cell + NCellsX - 1];
+            double add_x_value =
+                x_idx + 1 < NCellsX ? center[cell + 1] :
+                NXSide > 0 ? center[cell] :
+                prev[idx + add_x].intencity[cell + 1 - NCellsX];
+            double sub_y_value =
+                y_idx > 0 ? center[cell - NCellsX] :
+                NYSide < 0 ? center[cell] :
+                prev[idx + sub_y].intencity[cell + (NCellsY - 1) * NCellsX];
+            double add_y_value =
+                y_idx + 1 < NCellsY ? center[cell + NCellsX] :
+                NYSide > 0 ? center[cell] :
+                prev[idx + add_y].intencity[x_idx];
+
+            double value2 = 2.0 * value;
+            double courant2 = velocity[cell] * velocity[cell] * courant2_;
+
+            result[cell] =
+                ((add_y_value + sub_y_value - value2) +
+                 (add_x_value + sub_x_value - value2)
+                 ) * courant2 -
+                layers[AIdx[2]][idx].intencity[cell];
+        }
+
+        for (size_t cell = 0; cell < NCellsX * NCellsY; ++cell)
+            layers[AIdx[0]][idx].intencity[cell] = result[cell];
+    }
+
+private:
+    std::shared_ptr<const TVelocityLayer> velocity_;
+    double courant2_ = 0.0;
+};
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_STENCIL_VELOCITY_WAVE_STENCIL2D_H_
@@ -0,0 +1,233 @@
+/**
+ * @file
+ * @author Egor Elchinov <elchinov.es@gmail.com>
+ * @version 2.0
+ *
+ * Microbenchmark of the synchronization primitives
+ * under the ConeFold dependency pattern.
+ * Each node of the cells grid waits on its own semaphore for the right
+ * and the bottom nodes of its time level and for the top-left node
+ * of the previous one. Nodes are distributed between the threads
+ * by wavefronts, so the threads block only on the real dependencies.
+ */
+
+#include "parallel/counting_semaphore.h"
+#include "parallel/hybrid_semaphore.h"
+#include "parallel/sync_array.h"
+
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+#include <cstdint>
+#include <cstdlib>
+
+/// @brief
+using namespace wave_model;
+
+/// Dependency pattern of the ConeFold grid
+struct Pattern
+{
+    size_t count;
+    std::vector<size_t> in_degrees;
+    std::vector<std::vector<size_t>> successors;
+    std::vector<std::vector<size_t>> lists; ///< nodes of each thread
+};
+
+/**
+ * @brief Builds the pattern of cells_cnt x cells_cnt cells per level
+ * @param cells_cnt Number of cells by each axis
+ * @param levels_cnt Number of time levels
+ * @param threads_cnt Number of threads
+ */
+Pattern build_pattern(size_t cells_cnt, size_t levels_cnt, size_t threads_cnt)
+{
+    const size_t level_size = cells_cnt * cells_cnt;
+
+    Pattern pattern = {};
+    pattern.count = level_size * levels_cnt;
+    pattern.in_degrees.assign(pattern.count, 0);
+    pattern.successors.assign(pattern.count, {});
+    pattern.lists.assign(threads_cnt, {});
+
+    auto add_edge = [&pattern](size_t from, size_t to) {
+            pattern.successors[from].push_back(to);
+            ++pattern.in_degrees[to];
+        };
+
+    std::vector<size_t> levels(pattern.count, 0);
+    for (size_t idx = 0; idx < pattern.count; ++idx)
+    {
+        size_t time = idx / level_size;
+        size_t x_idx = idx % cells_cnt;
+        size_t y_idx = idx % level_size / cells_cnt;
+
+        if (x_idx + 1 < cells_cnt)
+            add_edge(idx + 1, idx);
+        if (y_idx + 1 < cells_cnt)
+            add_edge(idx + cells_cnt, idx);
+        if (x_idx > 0 && y_idx > 0 && time > 0)
+            add_edge(idx - level_size - cells_cnt - 1, idx);
+    }
+
+    // the wavefront of the node is its longest dependency chain
+    std::vector<size_t> order;
+    for (size_t time = 0; time < levels_cnt; ++time)
+    {
+        for (size_t diag = 2 * cells_cnt - 1; diag-- > 0;)
+        {
+            for (size_t y_idx = 0; y_idx < cells_cnt; ++y_idx)
+            {
+                if (diag < y_idx || diag - y_idx >= cells_cnt)
+                    continue;
+
+                order.push_back(time * level_size + y_idx * cells_cnt +
+                                diag - y_idx);
+            }
+        }
+    }
+
+    for (size_t idx : order)
+    {
+        for (size_t successor : pattern.successors[idx])
+            levels[successor] = std::max(levels[successor], levels[idx] + 1);
+    }
+
+    std::stable_sort(std::begin(order), std::end(order),
+                     [&levels](size_t lhs, size_t rhs) {
+                         return levels[lhs] < levels[rhs];
+                     });
+
+    for (size_t pos = 0, first = 0; pos < order.size(); ++pos)
+    {
+        if (levels[order[pos]] != levels[order[first]])
+            first = pos;
+
+        pattern.lists[(pos - first) % threads_cnt].push_back(order[pos]);
+    }
+
+    return pattern;
+}
+
+/**
+ * @brief Runs the pattern once and returns its time in microseconds
+ * @tparam TSemaphore Semaphore type
+ * @param pattern Dependency pattern
+ * @param layout Layout of the semaphores array
+ * @param work_cnt Number of dummy operations per node
+ */
+template<typename TSemaphore>
+double run_pattern(const Pattern& pattern, WmSyncLayout::EKind layout,
+                   size_t work_cnt)
+{
+    using TClock = std::chrono::steady_clock;
+
+    WmSyncArray<TSemaphore> semaphores(pattern.count, layout);
+
+    auto start = TClock::now();
+
+    std::vector<std::thread> threads;
+    for (const auto& list : pattern.lists)
+    {
+        threads.emplace_back([&pattern, &semaphores, &list, work_cnt]() {
+                volatile double sink = 0.0;
+
+                for (size_t idx : list)
+                {
+                    for (size_t dep = 0; dep < pattern.in_degrees[idx]; ++dep)
+                        semaphores[idx].acquire();
+
+                    for (size_t op = 0; op < work_cnt; ++op)
+                        sink = sink + 1.0;
+
+                    for (size_t successor : pattern.successors[idx])
+                        semaphores[successor].release();
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    return std::chrono::duration<double, std::micro>(
+            TClock::now() - start).count();
+}
+
+/**
+ * @brief Prints the best and the mean times of runs_cnt runs
+ */
+template<typename TSemaphore>
+void report(const std::string& name, const Pattern& pattern,
+            size_t work_cnt, size_t runs_cnt)
+{
+    static constexpr const char* NLayoutNames[] = {
+        "packed", "padded", "striped"
+    };
+
+    WmSyncLayout::EKind layouts[] = {
+        WmSyncLayout::LAYOUT_PACKED,
+        WmSyncLayout::LAYOUT_PADDED,
+        WmSyncLayout::LAYOUT_STRIPED
+    };
+
+    for (WmSyncLayout::EKind layout : layouts)
+    {
+        double best = 0.0;
+        double total = 0.0;
+
+        for (size_t run_idx = 0; run_idx < runs_cnt; ++run_idx)
+        {
+            double time = run_pattern<TSemaphore>(pattern, layout, work_cnt);
+
+            best = run_idx == 0 ? time : std::min(best, time);
+            total += time;
+        }
+
+        std::cout << name << ' ' << NLayoutNames[layout]
+                  << " best: " << best << " us"
+                  << " mean: " << total / runs_cnt << " us\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "--help")
+    {
+        std::cerr << "USAGE: " << argv[0]
+                  << " [THREADS [CELLS [LEVELS [WORK [RUNS]]]]]\n";
+        return 0;
+    }
+
+    auto arg = [argc, argv](int idx, size_t value) -> size_t {
+            return argc > idx ? std::strtoull(argv[idx], nullptr, 10) : value;
+        };
+
+    size_t threads_cnt = std::max<size_t>(arg(1, 4), 1);
+    size_t cells_cnt = std::max<size_t>(arg(2, 16), 1);
+    size_t levels_cnt = std::max<size_t>(arg(3, 16), 1);
+    size_t work_cnt = arg(4, 1000);
+    size_t runs_cnt = std::max<size_t>(arg(5, 10), 1);
+
+    Pattern pattern = build_pattern(cells_cnt, levels_cnt, threads_cnt);
+
+    std::cout << "threads: " << threads_cnt
+              << " nodes: " << pattern.count
+              << " work: " << work_cnt << '\n';
+
+#if defined(__cpp_lib_semaphore)
+    report<WmCountingSemaphore<INT32_MAX>>(
+            "std::counting_semaphore", pattern, work_cnt, runs_cnt);
+
+#else // __cpp_lib_semaphore
+    report<WmCountingSemaphore<INT32_MAX>>(
+            "mutex+condvar", pattern, work_cnt, runs_cnt);
+
+#endif // __cpp_lib_semaphore
+
+    report<WmHybridSemaphore>("hybrid", pattern, work_cnt, runs_cnt);
+
+    return 0;
+}
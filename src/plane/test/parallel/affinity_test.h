@@ -0,0 +1,19 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_AFFINITY_H_
+#define WAVE_MODEL_TEST_PARALLEL_AFFINITY_H_
+
+#include "parallel/affinity.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_affinity(TStream& stream)
+{
+    WmCpuTopology::Test::test_parse(stream);
+    WmCpuTopology::Test::test_assign(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_AFFINITY_H_
@@ -0,0 +1,22 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_BATCH_RUNNER_H_
+#define WAVE_MODEL_TEST_PARALLEL_BATCH_RUNNER_H_
+
+#include "parallel/batch_runner.h"
+#include "parallel/sequential_executor.h"
+#include "parallel/thread_pool_executor.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_batch_runner(TStream& stream)
+{
+    WmBatchRunner<void>::Test::test_init(stream);
+    WmBatchRunner<void>::Test::test_run<WmSequentialExecutor>(stream);
+    WmBatchRunner<void>::Test::test_run<WmThreadPoolExecutor>(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_BATCH_RUNNER_H_
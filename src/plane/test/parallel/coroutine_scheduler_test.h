@@ -0,0 +1,25 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_COROUTINE_SCHEDULER_H_
+#define WAVE_MODEL_TEST_PARALLEL_COROUTINE_SCHEDULER_H_
+
+#include "parallel/coroutine_scheduler.h"
+#include "parallel/sequential_executor.h"
+#include "parallel/work_stealing_executor.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_coroutine_scheduler(TStream& stream)
+{
+#if defined(WM_HAS_COROUTINES)
+    WmCoroutineScheduler::Test::test_init(stream);
+    WmCoroutineScheduler::Test::test_run<WmSequentialExecutor>(stream);
+    WmCoroutineScheduler::Test::test_run<WmWorkStealingExecutor>(stream);
+
+#endif // defined(WM_HAS_COROUTINES)
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_COROUTINE_SCHEDULER_H_
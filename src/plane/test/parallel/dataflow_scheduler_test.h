@@ -0,0 +1,22 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_DATAFLOW_SCHEDULER_H_
+#define WAVE_MODEL_TEST_PARALLEL_DATAFLOW_SCHEDULER_H_
+
+#include "parallel/dataflow_scheduler.h"
+#include "parallel/sequential_executor.h"
+#include "parallel/work_stealing_executor.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_dataflow_scheduler(TStream& stream)
+{
+    WmDataflowScheduler::Test::test_init(stream);
+    WmDataflowScheduler::Test::test_run<WmSequentialExecutor>(stream);
+    WmDataflowScheduler::Test::test_run<WmWorkStealingExecutor>(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_DATAFLOW_SCHEDULER_H_
@@ -0,0 +1,18 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_EXECUTOR_METRICS_H_
+#define WAVE_MODEL_TEST_PARALLEL_EXECUTOR_METRICS_H_
+
+#include "parallel/executor_metrics.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_executor_metrics(TStream& stream)
+{
+    WmExecutorMetrics::Test::test_counters(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_EXECUTOR_METRICS_H_
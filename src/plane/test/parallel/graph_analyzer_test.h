@@ -0,0 +1,19 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_GRAPH_ANALYZER_H_
+#define WAVE_MODEL_TEST_PARALLEL_GRAPH_ANALYZER_H_
+
+#include "parallel/graph_analyzer.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_graph_analyzer(TStream& stream)
+{
+    WmGraphAnalyzer::Test::test_init(stream);
+    WmGraphAnalyzer::Test::test_metrics(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_GRAPH_ANALYZER_H_
@@ -0,0 +1,18 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_HYBRID_MUTEX_H_
+#define WAVE_MODEL_TEST_PARALLEL_HYBRID_MUTEX_H_
+
+#include "parallel/hybrid_mutex.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_hybrid_mutex(TStream& stream)
+{
+    WmHybridMutex::Test::test_lock(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_HYBRID_MUTEX_H_
@@ -0,0 +1,18 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_HYBRID_SEMAPHORE_H_
+#define WAVE_MODEL_TEST_PARALLEL_HYBRID_SEMAPHORE_H_
+
+#include "parallel/hybrid_semaphore.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_hybrid_semaphore(TStream& stream)
+{
+    WmHybridSemaphore::Test::test_run(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_HYBRID_SEMAPHORE_H_
@@ -0,0 +1,21 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_NODE_SPLITTER_H_
+#define WAVE_MODEL_TEST_PARALLEL_NODE_SPLITTER_H_
+
+#include "parallel/node_splitter.h"
+#include "parallel/sequential_executor.h"
+#include "parallel/work_stealing_executor.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_node_splitter(TStream& stream)
+{
+    WmNodeSplitter<void>::Test::test_split<WmSequentialExecutor>(stream);
+    WmNodeSplitter<void>::Test::test_split<WmWorkStealingExecutor>(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_NODE_SPLITTER_H_
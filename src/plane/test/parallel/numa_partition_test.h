@@ -0,0 +1,18 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_NUMA_PARTITION_H_
+#define WAVE_MODEL_TEST_PARALLEL_NUMA_PARTITION_H_
+
+#include "parallel/numa_partition.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_numa_partition(TStream& stream)
+{
+    WmNumaPartition::Test::test_strips(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_NUMA_PARTITION_H_
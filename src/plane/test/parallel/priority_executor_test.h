@@ -0,0 +1,19 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_PRIORITY_EXECUTOR_H_
+#define WAVE_MODEL_TEST_PARALLEL_PRIORITY_EXECUTOR_H_
+
+#include "parallel/priority_executor.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_priority_executor(TStream& stream)
+{
+    WmPriorityExecutor::Test::test_init(stream);
+    WmPriorityExecutor::Test::test_order(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_PRIORITY_EXECUTOR_H_
@@ -0,0 +1,19 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_STATIC_SCHEDULER_H_
+#define WAVE_MODEL_TEST_PARALLEL_STATIC_SCHEDULER_H_
+
+#include "parallel/static_scheduler.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_static_scheduler(TStream& stream)
+{
+    WmStaticScheduler::Test::test_init(stream);
+    WmStaticScheduler::Test::test_run(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_STATIC_SCHEDULER_H_
@@ -0,0 +1,19 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_SYNC_ARRAY_H_
+#define WAVE_MODEL_TEST_PARALLEL_SYNC_ARRAY_H_
+
+#include "parallel/sync_array.h"
+#include "parallel/hybrid_semaphore.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_sync_array(TStream& stream)
+{
+    WmSyncArray<WmHybridSemaphore>::Test::test_layout(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_SYNC_ARRAY_H_
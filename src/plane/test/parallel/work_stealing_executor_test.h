@@ -0,0 +1,20 @@
+#ifndef WAVE_MODEL_TEST_PARALLEL_WORK_STEALING_EXECUTOR_H_
+#define WAVE_MODEL_TEST_PARALLEL_WORK_STEALING_EXECUTOR_H_
+
+#include "parallel/work_stealing_executor.h"
+
+namespace wave_model {
+
+template<typename TStream>
+TStream& wm_test_work_stealing_executor(TStream& stream)
+{
+    WmWorkStealingExecutor::Test::test_init(stream);
+    WmWorkStealingExecutor::Test::test_run(stream);
+    WmWorkStealingExecutor::Test::test_batch(stream);
+
+    return stream;
+}
+
+} // namespace wave_model
+
+#endif // WAVE_MODEL_TEST_PARALLEL_WORK_STEALING_EXECUTOR_H_
@@ -30,6 +30,9 @@ struct WmGeneralConeFoldTiling2D
     static constexpr size_t NTileRank = NR;
     // static constexpr size_t NDepth = 1u << NTileRank;
 
+    /// Default rank of folds processed sequentially by traverse_forked()
+    static constexpr size_t NForkCutoffRank = 4;
+
     enum EType
     {
         TYPE_A, TYPE_B, TYPE_C, TYPE_D, TYPE_N
@@ -59,30 +62,54 @@ struct WmGeneralConeFoldTiling2D
         traverse_chunk<NQuadCnt, NRank, 0, NQuadCnt>(stencil, layers);
     }
 
+    /**
+     * @brief Traverses the domain in fork-join manner using OpenMP tasks
+     * Independent folds above NCutoffRank are spawned as tasks,
+     * the rest are processed sequentially as in traverse().
+     * Runs sequentially if compiled without OpenMP.
+     * @tparam NCutoffRank Maximal rank of the sequentially processed fold
+     */
+    template<size_t NRank, size_t NCutoffRank = NForkCutoffRank,
+             typename TStencil, typename TGeneralLayer>
+    static void traverse_forked(const TStencil& stencil, 
+                                TGeneralLayer* layers) noexcept
+    {
+        // guaranteed to be 2's power
+        static constexpr size_t NQuadCnt = 
+            TGeneralLayer::NDomainLengthY / TGeneralLayer::NDomainLengthX;
+
+        #pragma omp parallel
+        #pragma omp single
+        traverse_chunk<NQuadCnt, NRank, 0, NQuadCnt, NCutoffRank>
+            (stencil, layers);
+    }
+
     // TODO: to replace length with rank
     template<size_t NChunkLength, size_t NRank, 
-             size_t NQuadIdx, size_t NQuadCnt,
+             size_t NQuadIdx, size_t NQuadCnt, size_t NCutoffRank = NRank,
              typename TStencil, typename TGeneralLayer>
     static void traverse_chunk(const TStencil& stencil, 
                                TGeneralLayer* layers) noexcept
     {
         if constexpr (NChunkLength == 1)
         {
-            traverse_quad<NRank, NQuadIdx, NQuadCnt>(stencil, layers);
+            traverse_quad<NRank, NQuadIdx, NQuadCnt, NCutoffRank>
+                (stencil, layers);
         }
         else
         {
             static constexpr size_t NHalfLength = NChunkLength / 2;
 
             // calculate bottom - to top
-            traverse_chunk<NHalfLength, NRank, 
-                           NQuadIdx + NHalfLength, NQuadCnt>(stencil, layers);
-            traverse_chunk<NHalfLength, NRank, 
-                           NQuadIdx, NQuadCnt>(stencil, layers);
+            traverse_chunk<NHalfLength, NRank, NQuadIdx + NHalfLength, 
+                           NQuadCnt, NCutoffRank>(stencil, layers);
+            traverse_chunk<NHalfLength, NRank, NQuadIdx, 
+                           NQuadCnt, NCutoffRank>(stencil, layers);
         }
     }
 
     template<size_t NRank, size_t NQuadIdx, size_t NQuadCnt,
+             size_t NCutoffRank = NRank,
              typename TStencil, typename TGeneralLayer>
     static void traverse_quad(const TStencil& stencil, 
             TGeneralLayer* layers) noexcept
@@ -116,35 +143,162 @@ struct WmGeneralConeFoldTiling2D
         int64_t x_off_2 = TGeneralLayer::template off_right<NLess>(NIdx, 2);
         int64_t y_off_2 = TGeneralLayer::template off_bottom<NLess>(NIdx, 2);
 
+        // folds of the same diag are independent
+        static constexpr bool NFork = NLess > NCutoffRank;
+
         // diag 4
-        proc_fold<NLess, TYPE_D, NYTypeD, 0>
+        proc_fold_forked<NLess, NCutoffRank, TYPE_D, NYTypeD, 0>
             (NIdx + x_off_2 + y_off_2, stencil, layers);
 
         // diag 3
-        proc_fold<NLess, TYPE_B, NYTypeD, 0>
-            (NIdx + x_off_1 + y_off_2, stencil, layers);
-        proc_fold<NLess, TYPE_D, NYTypeB, 0>
-            (NIdx + x_off_2 + y_off_1, stencil, layers);
+        fork_join<NFork>(
+            [&]() {
+                proc_fold_forked<NLess, NCutoffRank, TYPE_B, NYTypeD, 0>
+                    (NIdx + x_off_1 + y_off_2, stencil, layers);
+            },
+            [&]() {
+                proc_fold_forked<NLess, NCutoffRank, TYPE_D, NYTypeB, 0>
+                    (NIdx + x_off_2 + y_off_1, stencil, layers);
+            });
 
         // diag 2
-        proc_fold<NLess, TYPE_B, NYTypeB, 0>
-            (NIdx + x_off_1 + y_off_1, stencil, layers);
-        proc_fold<NLess, TYPE_A, NYTypeD, 0>
-            (NIdx + y_off_2,           stencil, layers);
-        proc_fold<NLess, TYPE_D, NYTypeA, 0>
-            (NIdx + x_off_2,           stencil, layers);
+        fork_join<NFork>(
+            [&]() {
+                proc_fold_forked<NLess, NCutoffRank, TYPE_B, NYTypeB, 0>
+                    (NIdx + x_off_1 + y_off_1, stencil, layers);
+            },
+            [&]() {
+                proc_fold_forked<NLess, NCutoffRank, TYPE_A, NYTypeD, 0>
+                    (NIdx + y_off_2,           stencil, layers);
+            },
+            [&]() {
+                proc_fold_forked<NLess, NCutoffRank, TYPE_D, NYTypeA, 0>
+                    (NIdx + x_off_2,           stencil, layers);
+            });
 
         // diag 1
-        proc_fold<NLess, TYPE_A, NYTypeB, 0>
-            (NIdx + y_off_1,           stencil, layers);
-        proc_fold<NLess, TYPE_B, NYTypeA, 0>
-            (NIdx + x_off_1,           stencil, layers);
+        fork_join<NFork>(
+            [&]() {
+                proc_fold_forked<NLess, NCutoffRank, TYPE_A, NYTypeB, 0>
+                    (NIdx + y_off_1,           stencil, layers);
+            },
+            [&]() {
+                proc_fold_forked<NLess, NCutoffRank, TYPE_B, NYTypeA, 0>
+                    (NIdx + x_off_1,           stencil, layers);
+            });
 
         // diag 0
-        proc_fold<NLess, TYPE_A, NYTypeA, 0>
+        proc_fold_forked<NLess, NCutoffRank, TYPE_A, NYTypeA, 0>
             (NIdx,                     stencil, layers);
     }
 
+    /**
+     * @brief Runs the functions as OpenMP tasks and waits for them
+     * Runs them one by one if NFork is false.
+     */
+    template<bool NFork, typename... TFuncs>
+    static void fork_join(TFuncs... funcs) noexcept
+    {
+        if constexpr (NFork)
+        {
+            (spawn(funcs), ...);
+
+            #pragma omp taskwait
+        }
+        else
+        {
+            (funcs(), ...);
+        }
+    }
+
+    template<typename TFunc>
+    static void spawn(TFunc func) noexcept
+    {
+        #pragma omp task firstprivate(func)
+        func();
+    }
+
+    /**
+     * @brief Processes the fold spawning its independent sub-folds as tasks
+     * In each time half 0Y and X0 sub-folds are independent. 
+     * Folds of NCutoffRank and less are processed by proc_fold().
+     */
+    template<size_t NRank, size_t NCutoffRank, 
+             EType NXType, EType NYType, size_t NLayerIdx, 
+             typename TStencil, typename TGeneralLayer>
+    static void proc_fold_forked(int64_t idx, 
+            const TStencil& stencil, TGeneralLayer* layers) noexcept
+    {
+        if constexpr (NXType == TYPE_N || NYType == TYPE_N)
+        {
+            return;
+        }
+        else if constexpr (NRank <= NCutoffRank)
+        {
+            proc_fold<NRank, NXType, NYType, NLayerIdx>(idx, stencil, layers);
+        }
+        else
+        {
+            static constexpr size_t NLess = NRank - 1;
+            static constexpr size_t NMod = TStencil::NDepth;
+            static constexpr size_t NUpperIdx = 
+                (NLayerIdx + (1 << NLess)) % NMod;
+
+            int64_t x_dec = TGeneralLayer::template off_left<NLess>(idx, 1);
+            int64_t y_dec = TGeneralLayer::template off_top<NLess>(idx, 1);
+            int64_t x_inc = TGeneralLayer::template off_right<NLess>(idx, 1);
+            int64_t y_inc = TGeneralLayer::template off_bottom<NLess>(idx, 1);
+
+            proc_fold_forked<NLess, NCutoffRank, 
+                             TypeMtx[NXType][1], TypeMtx[NYType][1], NLayerIdx>
+                (idx, stencil, layers); // XY
+
+            fork_join<true>(
+                [=, &stencil]() {
+                    proc_fold_forked<NLess, NCutoffRank, TypeMtx[NXType][0], 
+                                     TypeMtx[NYType][1], NLayerIdx>
+                        (idx + x_dec, stencil, layers); // 0Y
+                },
+                [=, &stencil]() {
+                    proc_fold_forked<NLess, NCutoffRank, TypeMtx[NXType][1], 
+                                     TypeMtx[NYType][0], NLayerIdx>
+                        (idx + y_dec, stencil, layers); // X0
+                });
+
+            proc_fold_forked<NLess, NCutoffRank, 
+                             TypeMtx[NXType][0], TypeMtx[NYType][0], NLayerIdx>
+                (idx + x_dec + y_dec, stencil, layers); // 00
+
+            // upper layer
+            if constexpr (NRank <= NTileRank)
+            {
+                proc_fold_forked<NLess, NCutoffRank, 
+                                 TypeMtx[NXType][3], TypeMtx[NYType][3], 
+                                 NUpperIdx>
+                    (idx + x_inc + y_inc, stencil, layers); // XY
+
+                fork_join<true>(
+                    [=, &stencil]() {
+                        proc_fold_forked<NLess, NCutoffRank, 
+                                         TypeMtx[NXType][2], 
+                                         TypeMtx[NYType][3], NUpperIdx>
+                            (idx + y_inc, stencil, layers); // 0Y
+                    },
+                    [=, &stencil]() {
+                        proc_fold_forked<NLess, NCutoffRank, 
+                                         TypeMtx[NXType][3], 
+                                         TypeMtx[NYType][2], NUpperIdx>
+                            (idx + x_inc, stencil, layers); // X0
+                    });
+
+                proc_fold_forked<NLess, NCutoffRank, 
+                                 TypeMtx[NXType][2], TypeMtx[NYType][2], 
+                                 NUpperIdx>
+                    (idx, stencil, layers); // 00
+            }
+        }
+    }
+
     template<size_t NRank, EType NXType, EType NYType, size_t NLayerIdx, 
              typename TStencil, typename TGeneralLayer>
     static void proc_fold(int64_t idx, 
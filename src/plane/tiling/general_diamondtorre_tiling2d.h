@@ -136,9 +136,34 @@ struct WmGeneralDiamondTorreTiling2D
         /* [OFFSET_N] = */ OFFSET_N
     };
 
+    /// Line of torres (column of poles) being processed as a whole
+    struct Line
+    {
+        int64_t coord; ///< x coordinate of the line
+        int64_t idx; ///< index of the bottom pole in layer
+        int64_t layer_idx; ///< time layer the poles start at
+        EOffset offset; ///< offset type of the line
+        ELine type; ///< right or left half-column
+    };
+
     template<size_t NRank, typename TStencil, typename TGeneralLayer>
     static void traverse(const TStencil& stencil, TGeneralLayer* layers) 
                          noexcept
+    {
+        for_each_line<NRank, TGeneralLayer>([&](const Line& line) {
+                dispatch_line<NRank>(line, stencil, layers, 
+                                     [](int64_t) noexcept {});
+            });
+    }
+
+    /**
+     * @brief Enumerates lines in the order of traverse()
+     * Each line depends only on the lines enumerated before it,
+     * the nearest of which is the previous one.
+     * @param func Function called for each line
+     */
+    template<size_t NRank, typename TGeneralLayer, typename TLineFunc>
+    static void for_each_line(TLineFunc&& func)
     {
         int64_t left_idx = 
             TGeneralLayer::template 
@@ -151,20 +176,16 @@ struct WmGeneralDiamondTorreTiling2D
             TGeneralLayer::template off_top<NTileRank - 1>(left_idx, 1);
 
         int64_t col = TGeneralLayer::NDomainLengthX;
-        proc_line<NRank, OFFSET_G, LINE_R>
-            (col + NTileSize / 2, right_idx, 0, stencil, layers);
-        proc_line<NRank, OFFSET_F, LINE_L>
-            (col, left_idx, 0, stencil, layers);
+        func(Line{ col + NTileSize / 2, right_idx, 0, OFFSET_G, LINE_R });
+        func(Line{ col, left_idx, 0, OFFSET_F, LINE_L });
 
         right_idx += TGeneralLayer::template 
             off_left<NTileRank>(right_idx, 1);
         left_idx += TGeneralLayer::template 
             off_left<NTileRank>(left_idx, 1);
 
-        proc_line<NRank, OFFSET_E, LINE_R>
-            (col + NTileSize / 2, right_idx, 0, stencil, layers);
-        proc_line<NRank, OFFSET_D, LINE_L>
-            (col, left_idx, 0, stencil, layers);
+        func(Line{ col + NTileSize / 2, right_idx, 0, OFFSET_E, LINE_R });
+        func(Line{ col, left_idx, 0, OFFSET_D, LINE_L });
 
         for (col = col - 2 * NTileSize; col >= NTileSize; col -= NTileSize)
         {
@@ -173,10 +194,8 @@ struct WmGeneralDiamondTorreTiling2D
             left_idx += TGeneralLayer::template 
                 off_left<NTileRank>(left_idx, 1);
 
-            proc_line<NRank, OFFSET_C, LINE_R>
-                (col + NTileSize / 2, right_idx, 0, stencil, layers);
-            proc_line<NRank, OFFSET_C, LINE_L>
-                (col, left_idx, 0, stencil, layers);
+            func(Line{ col + NTileSize / 2, right_idx, 0, OFFSET_C, LINE_R });
+            func(Line{ col, left_idx, 0, OFFSET_C, LINE_L });
         }
 
         right_idx += TGeneralLayer::template 
@@ -184,31 +203,76 @@ struct WmGeneralDiamondTorreTiling2D
         left_idx += TGeneralLayer::template 
             off_left<NTileRank>(left_idx, 1);
 
-        proc_line<NRank, OFFSET_B, LINE_R>
-            (col + NTileSize / 2, right_idx, 0, stencil, layers);
-        proc_line<NRank, OFFSET_A, LINE_L>
-            (col, left_idx, 0, stencil, layers);
+        func(Line{ col + NTileSize / 2, right_idx, 0, OFFSET_B, LINE_R });
+        func(Line{ col, left_idx, 0, OFFSET_A, LINE_L });
 
         for (size_t cur_time = 0; cur_time < (1u << NRank);)
         {
             cur_time += NTileSize / 2;
-            proc_line<NRank, OFFSET_A, LINE_R>
-                (0, left_idx, cur_time, stencil, layers);
+            func(Line{ 0, left_idx, static_cast<int64_t>(cur_time),
+                       OFFSET_A, LINE_R });
 
             cur_time += NTileSize / 2;
-            proc_line<NRank, OFFSET_A, LINE_L>
-                (0, left_idx, cur_time, stencil, layers);
+            func(Line{ 0, left_idx, static_cast<int64_t>(cur_time),
+                       OFFSET_A, LINE_L });
+        }
+    }
+
+    /**
+     * @brief Returns number of poles in the line
+     */
+    template<typename TGeneralLayer>
+    static constexpr int64_t pole_count(ELine type) noexcept
+    {
+        return TGeneralLayer::NDomainLengthY / NTileSize + 
+               (type == LINE_L ? 1 : 0);
+    }
+
+    /**
+     * @brief Processes the line choosing its offset and type at runtime
+     * @param line Line to process
+     * @param sync Called with number of processed poles before each pole
+     * and after the last one
+     */
+    template<size_t NRank, EOffset NOffset = OFFSET_A,
+             typename TStencil, typename TGeneralLayer, typename TSync>
+    static void dispatch_line(const Line& line, const TStencil& stencil,
+                              TGeneralLayer* layers, TSync&& sync)
+    {
+        if (line.offset != NOffset)
+        {
+            if constexpr (NOffset + 1 < OFFSET_N)
+            {
+                dispatch_line<NRank, static_cast<EOffset>(NOffset + 1)>
+                    (line, stencil, layers, sync);
+            }
+
+            return;
+        }
+
+        if (line.type == LINE_R)
+        {
+            proc_line<NRank, NOffset, LINE_R>(line.coord, line.idx,
+                    line.layer_idx, stencil, layers, sync);
+        }
+        else
+        {
+            proc_line<NRank, NOffset, LINE_L>(line.coord, line.idx,
+                    line.layer_idx, stencil, layers, sync);
         }
     }
 
     template<size_t NRank, EOffset NOffset, ELine NType, 
-             typename TStencil, typename TGeneralLayer>
+             typename TStencil, typename TGeneralLayer, typename TSync>
     static void proc_line(int64_t coord, int64_t idx, int64_t layer_idx, 
-                          const TStencil& stencil, TGeneralLayer* layers) 
-                          noexcept
+                          const TStencil& stencil, TGeneralLayer* layers,
+                          TSync&& sync)
     {
         WM_ASSERT(idx >= 0, "index must be non-negative");
 
+        int64_t pole_idx = 0;
+        sync(pole_idx++);
+
         if constexpr (NType == LINE_R)
         {
             proc_pole<NRank, NOffset, TYPE_C>
@@ -226,6 +290,7 @@ struct WmGeneralDiamondTorreTiling2D
             idx += TGeneralLayer::template 
                 off_top<NTileRank>(idx, 1);
 
+            sync(pole_idx++);
             proc_pole<NRank, NOffset, TYPE_B>
                 (coord, idx, layer_idx, stencil, layers);
         }
@@ -235,9 +300,12 @@ struct WmGeneralDiamondTorreTiling2D
             idx += TGeneralLayer::template 
                 off_top<NTileRank>(idx, 1);
 
+            sync(pole_idx++);
             proc_pole<NRank, NOffset, TYPE_A>
                 (coord, idx, layer_idx, stencil, layers);
         }
+
+        sync(pole_idx);
     }
 
     template<size_t NRank, EOffset NOffset, EType NType, 